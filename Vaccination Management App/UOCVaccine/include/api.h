@@ -9,6 +9,62 @@
 #include "center.h"
 #include "stock.h"
 #include "appointment.h"
+#include "cache.h"
+#include "arena.h"
+#include "postalcode.h"
+#include "bitmap.h"
+#include "hold.h"
+#include "cursor.h"
+#include "columnar.h"
+
+// Maximum number of fields of an entry
+#define API_MAX_FIELDS 16
+
+struct _ApiData;
+
+// Handler that adds an entry of a given type from its fields
+typedef tApiError (*tApiEntryHandler)(struct _ApiData* data, char** fields, int numFields);
+
+// Entry type registered on an API data that is not known by the CSV parser
+typedef struct _tApiEntryType {
+    // Name of the type
+    char* name;
+    // Handler of the entries of the type
+    tApiEntryHandler handler;
+} tApiEntryType;
+
+// Entry handlers of an API data
+typedef struct _tApiEntryTypes {
+    // Handlers of the types known by the CSV parser, indexed by their type id
+    tApiEntryHandler known[CSV_NUM_TYPES];
+    // Other registered types
+    tApiEntryType* elems;
+    // Number of other registered types
+    int count;
+} tApiEntryTypes;
+
+// Maximum number of days of the stock read at once for a group of availability checks
+#define API_BATCH_MAX_DAYS 65536
+
+// Availability check of a batch
+typedef struct _tAvailabilityRequest {
+    // Postal code of the health center
+    const char* cp;
+    // Vaccine name
+    const char* vaccine;
+    // Day of the first dose
+    tDate date;
+} tAvailabilityRequest;
+
+// Availability check of a batch, sorted by health center, vaccine and day
+typedef struct _tAvailabilityBatchItem {
+    // Original request
+    const tAvailabilityRequest* request;
+    // Day number of the first dose
+    int day;
+    // Position of the request on the batch
+    int pos;
+} tAvailabilityBatchItem;
 
 
 // Type that stores all the application data
@@ -27,6 +83,24 @@ typedef struct _ApiData {
     // PR2 EX1a
     tHealthCenterList centers;
     ////////////////////////////////    
+    
+    // Cached availability answers. Allocated apart, so copies of this structure share it
+    tAvailabilityCache* availability;
+    
+    // Entry handlers of this data. Allocated apart, so copies of this structure share them
+    tApiEntryTypes* handlers;
+    
+    // Storage of the text fields of persons, lots and centers. Released at once
+    tStringArena* strings;
+    
+    // Postal codes shared by persons, lots and centers
+    tPostalCodeTable* cps;
+    
+    // If true, persons with a DNI or NIE are only added when their check letter is valid
+    bool checkDocuments;
+    
+    // Stock reserved while bookings are confirmed. Allocated apart, so copies of this structure share it
+    tHoldWheel* holds;
 } tApiData;
 
 // Get the API version information
@@ -38,6 +112,15 @@ tApiError api_loadData(tApiData* data, const char* filename, bool reset);
 // Add a new entry
 tApiError api_addDataEntry(tApiData* data, tCSVEntry entry);
 
+// Add a new entry from a CSV line. The line is modified to split the fields
+tApiError api_addDataLine(tApiData* data, char* line);
+
+// Register the handler for entries of a given type on this data, replacing the previous one. Other data are not changed
+tApiError api_registerEntryType(tApiData* data, const char* type, tApiEntryHandler handler);
+
+// Enable or disable the validation of the DNI and NIE check letters of new persons
+void api_setDocumentValidation(tApiData* data, bool enabled);
+
 // Free all used memory
 tApiError api_freeData(tApiData* data);
 
@@ -68,28 +151,166 @@ tApiError api_getVaccines(tApiData data, tCSVData *vaccines);
 // Get vaccine lots
 tApiError api_getVaccineLots(tApiData data, tCSVData *lots);
 
+// Call the visitor for each registered vaccine. Return the number of visited vaccines
+int api_visitVaccines(tApiData data, tVaccineVisitor visitor, void* context);
+
+// Call the visitor for each vaccine lot. Return the number of visited lots
+int api_visitVaccineLots(tApiData data, tVaccineLotVisitor visitor, void* context);
+
+// Open a cursor over the registered vaccines
+void api_openVaccineCursor(tApiData* data, tVaccineCursor* cursor);
+
+// Open a cursor over the vaccine lots
+void api_openLotCursor(tApiData* data, tLotCursor* cursor);
+
+// Open a cursor over the population
+void api_openPopulationCursor(tApiData* data, tPopulationCursor* cursor);
+
 // Get the number of health centers registered on the application
 int api_centersCount(tApiData data);
 
 // Print center stock
 void api_printCenterStock(tApiData data, const char* cp);
 
-// Add a new vaccination appointment
+// Write center stock with the format of api_printCenterStock
+void api_writeCenterStock(tApiData data, const char* cp, tReportWriter* writer);
+
+// Write a record for each vaccine lot, person and vaccination appointment, with the format of the writer. Return the number of records
+int api_dumpData(tApiData data, tReportWriter* writer);
+
+// Export the vaccine lots to a column file, with their timestamps as packed keys. Return E_FILE_NOT_FOUND if it cannot be written
+tApiError api_exportLots(tApiData data, const char* filename);
+
+// Export the vaccination appointments of all the health centers to a column file, one row for each dose, with their timestamps as packed keys. Return E_FILE_NOT_FOUND if it cannot be written
+tApiError api_exportAppointments(tApiData data, const char* filename);
+
+// Add a new vaccination appointment, taking its doses from the center stock
 tApiError api_addAppointment(tApiData* data, const char* cp, const char* document, const char* vaccine, tDateTime timestamp);
 
 // Get person appointments
 tApiError api_getPersonAppointments(tApiData data, const char* document, tCSVData *appointments);
 
+// Call the visitor for each vaccination appointment of a person
+tApiError api_visitPersonAppointments(tApiData data, const char* document, tAppointmentVisitor visitor, void* context);
+
+// Open a cursor over the vaccination appointments of a person. On errors the cursor is empty
+tApiError api_openPersonAppointmentCursor(tApiData* data, const char* document, tAppointmentCursor* cursor);
+
+// Open a cursor over the vaccination appointments of a health center. On errors the cursor is empty
+tApiError api_openCenterAppointmentCursor(tApiData* data, const char* cp, tAppointmentCursor* cursor);
+
 
 // Check availability of a vaccine in a given health center
 bool api_checkAvailability(tApiData data, const char* cp, const char* vaccine, tDate date);
 
-// Find available vaccination appointment
+// Get the first date not before the given one where a center has the doses of a vaccine for the given number of persons
+tApiError api_findEarliestAvailability(tApiData data, const char* cp, const char* vaccine, tDate date, int persons, tDate* first);
+
+// Get the first date not before the given one where a center has at least the given doses of a vaccine
+tApiError api_findEarliestStock(tApiData data, const char* cp, const char* vaccine, tDate date, int doses, tDate* first);
+
+// Store on result the positions of the requests with availability for all their doses. Result must be initialized and is replaced. Return the number of available requests
+int api_checkAvailabilityBatch(tApiData data, const tAvailabilityRequest* requests, int count, tBitmap* result);
+
+// Get the number of availability answers served from the cache and computed from the stock
+void api_getAvailabilityCacheStats(tApiData data, int* hits, int* misses);
+
+// Get the number of bytes used by the stored text fields
+size_t api_getStringsSize(tApiData data);
+
+// Set the appointments per slot of a center and its opening hours. A capacity of 0 removes the limit
+tApiError api_setCenterCapacity(tApiData* data, const char* cp, int capacity, tTime open, tTime close);
+
+// Get the number of persons waiting for vaccines on a center
+int api_waitlistCount(tApiData data, const char* cp);
+
+// Get the number of distinct postal codes
+int api_postalCodesCount(tApiData data);
+
+// Call the visitor for each person living on the given cp. Return the number of visited persons
+int api_visitResidents(tApiData data, const char* cp, tPersonVisitor visitor, void* context);
+
+// Call the visitor for each person living on a cp starting with the given prefix. Return the number of visited persons
+int api_visitRegionResidents(tApiData data, const char* prefix, tPersonVisitor visitor, void* context);
+
+// Store on result the persons living on a cp starting with the given prefix. Result must be initialized and is replaced
+void api_getResidentsSet(tApiData* data, const char* prefix, tBitmap* result);
+
+// Store on result the persons born before the cutoff. Result must be initialized and is replaced
+void api_getBornBeforeSet(tApiData* data, tDate cutoff, tBitmap* result);
+
+// Store on result the persons with appointments for a vaccine, or any vaccine if it is NULL. Result must be initialized and is replaced
+void api_getScheduledSet(tApiData* data, const char* vaccine, tBitmap* result);
+
+// Call the visitor for each person of a set. Return the number of visited persons
+int api_visitPersonSet(tApiData* data, const tBitmap* persons, tPersonVisitor visitor, void* context);
+
+// Call the visitor for each person without appointments born before the cutoff, from the oldest one. If cp is not NULL only its residents are visited. Return the number of visited persons
+int api_getEligibleCohort(tApiData* data, tDate birthdayCutoff, const char* cp, tPersonVisitor visitor, void* context);
+
+// Find available vaccination appointment. If there are no vaccines, the person waits for new lots on the center
 tApiError api_findAppointmentAvailability(tApiData* data, const char* cp, const char* document, tDateTime timestamp);
 
+// Cancel the vaccination appointments of a person, returning their doses to the center stock
+tApiError api_cancelAppointment(tApiData* data, const char* document);
+
+// Remove a person, cancelling its appointments, holds and requests. The positions of the next persons are updated on all the centers
+tApiError api_deletePerson(tApiData* data, const char* document);
+
+// Move the vaccination appointments of a person to a new first dose timestamp on the same center and vaccine. On centers with a slot limit, the first free slot of the day from the timestamp is used
+tApiError api_rescheduleAppointment(tApiData* data, const char* document, tDateTime timestamp);
+
+// Reserve the stock and the slots of all the doses of a vaccine for a person during the given minutes from now. The identifier of the hold is stored on hold. E_DUPLICATED_PERSON if the person is booked or has an active hold
+tApiError api_holdAppointment(tApiData* data, const char* cp, const char* document, const char* vaccine, tDateTime timestamp, tDateTime now, int minutes, int* hold);
+
+// Book the vaccination appointments reserved by a hold. If the booking fails the hold is kept
+tApiError api_confirmHold(tApiData* data, int hold);
+
+// Return the reserved stock and slots of a hold to the center
+tApiError api_releaseHold(tApiData* data, int hold);
+
+// Return the stock and the slots of the holds expired at the given time. Return the number of expired holds
+int api_expireHolds(tApiData* data, tDateTime now);
+
+
+// [AUX METHOD] Get the handler for entries of a type, given by its id if it is known by the CSV parser or by its name otherwise. NULL if there is no handler
+tApiEntryHandler api_getEntryHandler(tApiData* data, int typeId, const char* type);
+
+// [AUX METHOD] Add a new person from the fields of an entry
+tApiError api_addPersonFields(tApiData* data, char** fields, int numFields);
+
+// [AUX METHOD] Add a new vaccines lot from the fields of an entry
+tApiError api_addVaccineLotFields(tApiData* data, char** fields, int numFields);
+
+// [AUX METHOD] Compare two checks of a batch by health center, vaccine and day
+int api_batchItemCmp(const void* a, const void* b);
+
+// [AUX METHOD] Get the names of the vaccines in list order. The array must be released, but not the names
+char** api_getVaccineNames(tApiData data);
+
+// [AUX METHOD] Get the position of a vaccine in the vaccine list
+int api_getVaccineCode(tApiData data, const tVaccine* vaccine);
+
+// [AUX METHOD] Book the first available vaccine on the two weeks from the timestamp. Return false if there is no stock
+bool api_bookFirstAvailable(tApiData* data, tHealthCenter* center, const char* document, tDateTime timestamp);
+
+// [AUX METHOD] Move the timestamp to the first day until last with stock and a free slot for a vaccine. If complete is true all the doses must be available, otherwise only the first one. Return false if there is none
+bool api_findFirstBookable(tHealthCenter* center, tVaccine* vaccine, tDateTime* timestamp, tDate last, bool complete);
+
+// [AUX METHOD] Book the persons waiting on a center, from the one with the highest priority. Persons without stock keep waiting. Return the number of booked persons
+int api_backfillWaitlist(tApiData* data, tHealthCenter* center, tDateTime arrival);
+
+// [AUX METHOD] Return the stock and the slots of a hold. The context is the API data, where the person stops holding them
+void api_returnHoldStock(tHold* hold, void* context);
+
+// [AUX METHOD] Move the timestamp to the first slot of its day that is free for all the doses of the vaccine. Return false if there is none
+bool api_findSlot(tHealthCenter* center, tVaccine* vaccine, tDateTime* timestamp);
+
+// [AUX METHOD] Add appointments to the slots of the doses of a series. Negative values remove them
+void api_updateAppointmentSlots(tHealthCenter* center, tDoseSeries* series, int appointments);
 
-// [AUX METHOD] Update stock with person appointments
-void api_updateAppointmentStock(tHealthCenter* center, tPerson* person);
+// [AUX METHOD] Update stock with the doses of a series, adding the given number of doses for each one
+void api_updateAppointmentStock(tHealthCenter* center, tDoseSeries* series, int doses);
 
 
 #endif // __UOCVACCINE_API__H
\ No newline at end of file
@@ -8,6 +8,8 @@
 typedef struct _tAppointment {    
     // Timestamp of the vaccination appointment
     tDateTime timestamp;
+    // Packed timestamp, used to keep the list sorted
+    tDateTimeKey key;
     // Person
     tPerson* person;
     // Vaccine
@@ -23,6 +25,31 @@ typedef struct _tAppointmentData {
     int count;    
 } tAppointmentData;
 
+// Type that stores all the doses of a vaccine booked by a person
+typedef struct _tDoseSeries {
+    // Position of the person on the population. Positions are kept when the population grows and updated by api_deletePerson
+    int person;
+    // Vaccine
+    tVaccine* vaccine;
+    // Timestamp of the first dose
+    tDateTime first;
+    // Number of doses
+    int doses;
+    // Days between two consecutive doses
+    int interval;
+} tDoseSeries;
+
+// Type that stores a list of dose series
+typedef struct _tDoseSeriesData {
+    // Dose series, in booking order
+    tDoseSeries* elems;
+    // Number of elements
+    int count;
+} tDoseSeriesData;
+
+// Function called for each vaccination appointment of a query, with the cp of its health center
+typedef void (*tAppointmentVisitor)(const tAppointment* appointment, const char* cp, void* context);
+
 // Initializes a vaccination appointment data list
 void appointmentData_init(tAppointmentData* list);
 
@@ -38,4 +65,37 @@ int appointmentData_find(tAppointmentData list, tPerson* person, int start_pos);
 // Release a vaccination appointment data list
 void appointmentData_free(tAppointmentData* list);
 
+// Initialize a dose series with all the doses of the vaccine for the person on the given position
+void doseSeries_init(tDoseSeries* series, int person, tVaccine* vaccine, tDateTime first);
+
+// Get the timestamp of a dose of the series. The first dose is 0
+tDateTime doseSeries_getDose(tDoseSeries series, int dose);
+
+// Call the visitor for each dose of the series, from the first one. Persons are taken from the given array. Return the number of visited appointments
+int doseSeries_visit(const tDoseSeries* series, tPerson* persons, const char* cp, tAppointmentVisitor visitor, void* context);
+
+// Initializes a dose series list
+void doseSeriesData_init(tDoseSeriesData* list);
+
+// Add a dose series at the end of the list. Return its position
+int doseSeriesData_add(tDoseSeriesData* list, tDoseSeries series);
+
+// Remove the dose series on the given position. The last one is moved to this position
+void doseSeriesData_remove(tDoseSeriesData* list, int pos);
+
+// Update the person positions after the person on the given position is removed from the population. The person must not have series on the list
+void doseSeriesData_delPerson(tDoseSeriesData* list, int person);
+
+// Insert all the doses of the list on a vaccination appointment list. Persons are taken from the given array
+void doseSeriesData_expand(tDoseSeriesData list, tPerson* persons, tAppointmentData* appointments);
+
+// Call the visitor for each dose of all the series of the list, in booking order. Persons are taken from the given array. Return the number of visited appointments
+int doseSeriesData_visit(tDoseSeriesData list, tPerson* persons, const char* cp, tAppointmentVisitor visitor, void* context);
+
+// Release a dose series list
+void doseSeriesData_free(tDoseSeriesData* list);
+
+// [AUX METHOD] Get the position of the first appointment with a timestamp not before the given key
+int appointmentData_lowerBound(tAppointmentData list, tDateTimeKey key);
+
 #endif // __APPOINTMENT__H
\ No newline at end of file
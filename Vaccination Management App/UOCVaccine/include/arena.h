@@ -0,0 +1,46 @@
+#ifndef __ARENA__H
+#define __ARENA__H
+
+#include <stddef.h>
+
+// Default size of the blocks of a string arena
+#define STRING_ARENA_BLOCK_SIZE 65536
+
+// Block of memory of a string arena
+typedef struct _tStringArenaBlock {
+    // Previous block
+    struct _tStringArenaBlock* next;
+    // Size of the data
+    size_t size;
+    // Number of used bytes
+    size_t used;
+    // Stored strings
+    char data[];
+} tStringArenaBlock;
+
+// Bump-pointer storage for strings that are all released at once
+typedef struct _tStringArena {
+    // Block in use. It points to the previous ones
+    tStringArenaBlock* first;
+    // Number of used bytes
+    size_t used;
+    // Number of allocated blocks
+    int blocks;
+} tStringArena;
+
+// Initialize the arena
+void stringArena_init(tStringArena* arena);
+
+// Release all the strings stored on the arena
+void stringArena_free(tStringArena* arena);
+
+// Get space for a string of the given length, including the ending character
+char* stringArena_alloc(tStringArena* arena, size_t length);
+
+// Copy a string. If arena is NULL the copy is allocated with malloc
+char* stringArena_strdup(tStringArena* arena, const char* str);
+
+// Get the number of bytes used by the stored strings
+size_t stringArena_size(tStringArena* arena);
+
+#endif // __ARENA__H
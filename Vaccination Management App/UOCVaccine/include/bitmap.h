@@ -0,0 +1,92 @@
+#ifndef __BITMAP__H
+#define __BITMAP__H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Maximum number of values of an array container. Larger containers are stored as bitsets
+#define BITMAP_ARRAY_MAX 4096
+
+// Number of words of a bitset container
+#define BITMAP_BITSET_WORDS 1024
+
+// Values of a bitmap sharing the 16 high bits
+typedef struct _tBitmapContainer {
+    // High 16 bits of the values
+    uint16_t key;
+    // Number of values
+    int cardinality;
+    // Sorted low 16 bits of the values. NULL for bitset containers
+    uint16_t* values;
+    // Number of allocated values
+    int capacity;
+    // One bit per low 16 bits value. NULL for array containers
+    uint64_t* bits;
+} tBitmapContainer;
+
+// Compressed set of 32 bits values
+typedef struct _tBitmap {
+    // Containers sorted by key
+    tBitmapContainer* containers;
+    // Number of containers
+    int count;
+} tBitmap;
+
+// Function called for each value of a bitmap
+typedef void (*tBitmapVisitor)(uint32_t value, void* context);
+
+// Initialize an empty bitmap
+void bitmap_init(tBitmap* bitmap);
+
+// Release the bitmap data
+void bitmap_free(tBitmap* bitmap);
+
+// Copy the source bitmap to an initialized destination, replacing its values
+void bitmap_cpy(tBitmap* destination, const tBitmap* source);
+
+// Add a value
+void bitmap_add(tBitmap* bitmap, uint32_t value);
+
+// Remove a value
+void bitmap_remove(tBitmap* bitmap, uint32_t value);
+
+// Remove a value and decrease by one all the greater values
+void bitmap_removeShift(tBitmap* bitmap, uint32_t value);
+
+// Check if a value is on the bitmap
+bool bitmap_contains(const tBitmap* bitmap, uint32_t value);
+
+// Get the number of values
+int bitmap_cardinality(const tBitmap* bitmap);
+
+// Store on result the values on both bitmaps. Result must be initialized and is replaced
+void bitmap_and(const tBitmap* a, const tBitmap* b, tBitmap* result);
+
+// Store on result the values on any of the bitmaps. Result must be initialized and is replaced
+void bitmap_or(const tBitmap* a, const tBitmap* b, tBitmap* result);
+
+// Store on result the values on a that are not on b. Result must be initialized and is replaced
+void bitmap_andNot(const tBitmap* a, const tBitmap* b, tBitmap* result);
+
+// Call the visitor for each value, in increasing order
+void bitmap_visit(const tBitmap* bitmap, tBitmapVisitor visitor, void* context);
+
+// [AUX METHOD] Get the position of the container with the given key. If it does not exist, -(insertion position + 1)
+int bitmap_findContainer(const tBitmap* bitmap, uint16_t key);
+
+// [AUX METHOD] Get the position of the first value of an array container not lower than the given one
+int bitmap_arrayPos(const tBitmapContainer* container, uint16_t low);
+
+// [AUX METHOD] Insert an empty array container on the given position
+tBitmapContainer* bitmap_insertContainer(tBitmap* bitmap, int pos, uint16_t key);
+
+// [AUX METHOD] Remove the container on the given position
+void bitmap_removeContainer(tBitmap* bitmap, int pos);
+
+// [AUX METHOD] Write the values of a container as a bitset
+void bitmap_containerWords(const tBitmapContainer* container, uint64_t* words);
+
+// [AUX METHOD] Append a container with the values of a bitset, if it is not empty
+void bitmap_appendWords(tBitmap* bitmap, uint16_t key, const uint64_t* words);
+
+#endif // __BITMAP__H
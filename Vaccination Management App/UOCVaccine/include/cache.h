@@ -0,0 +1,56 @@
+#ifndef __CACHE__H
+#define __CACHE__H
+
+#include <stdbool.h>
+#include "date.h"
+#include "vaccine.h"
+#include "center.h"
+
+// Default number of entries of the availability cache
+#define AVAILABILITY_CACHE_SIZE 4096
+
+// Cached answer of an availability check
+typedef struct _tAvailabilityCacheEntry {
+    // Health center. NULL for empty entries
+    tHealthCenter* center;
+    // Vaccine
+    tVaccine* vaccine;
+    // Day of the first dose
+    tDate day;
+    // Stock epoch of the center when the answer was computed
+    int epoch;
+    // Cached answer
+    bool available;
+} tAvailabilityCacheEntry;
+
+// Bounded cache of availability answers
+typedef struct _tAvailabilityCache {
+    // Cache entries
+    tAvailabilityCacheEntry* elems;
+    // Number of entries
+    int size;
+    // Number of answers served from the cache
+    int hits;
+    // Number of answers that had to be computed
+    int misses;
+} tAvailabilityCache;
+
+// Initialize the cache with the given number of entries
+void availabilityCache_init(tAvailabilityCache* cache, int size);
+
+// Release the cache data
+void availabilityCache_free(tAvailabilityCache* cache);
+
+// Remove all the cached answers
+void availabilityCache_clear(tAvailabilityCache* cache);
+
+// Search a valid answer for the given center, vaccine and day. Return true if it was found
+bool availabilityCache_find(tAvailabilityCache* cache, tHealthCenter* center, tVaccine* vaccine, tDate day, bool* available);
+
+// Store the answer for the given center, vaccine and day
+void availabilityCache_store(tAvailabilityCache* cache, tHealthCenter* center, tVaccine* vaccine, tDate day, bool available);
+
+// [AUX METHOD] Get the position of the entry for the given center, vaccine and day
+int availabilityCache_slot(tAvailabilityCache* cache, tHealthCenter* center, tVaccine* vaccine, tDate day);
+
+#endif // __CACHE__H
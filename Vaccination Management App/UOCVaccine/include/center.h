@@ -3,15 +3,26 @@
 
 #include "stock.h"
 #include "appointment.h"
+#include "arena.h"
+#include "postalcode.h"
+#include "waitlist.h"
+#include "slots.h"
 
 // Health center
 typedef struct _tHealthCenter {    
     char* cp;
+    // Identifier of the cp on the postal code table. POSTAL_CODE_UNKNOWN if it is not interned
+    int cpId;
     tVaccineStockData stock;  
     //////////////////////////////////
     // Ex PR3 2a
     /////////////////////////////////
-    tAppointmentData appointments;
+    // Booked dose series. Use doseSeriesData_expand to get one appointment per dose
+    tDoseSeriesData series;
+    // Persons waiting for vaccines on this center
+    tWaitlist waitlist;
+    // Appointments by slot, limited by the capacity of the center
+    tSlotCalendar slots;
 } tHealthCenter;
 
 // Health center list node
@@ -24,12 +35,19 @@ typedef struct _tHealthCenterNode {
 typedef struct _tHealthCenterList {    
     tHealthCenterNode* first;
     int count;
+    // Storage of the center cps. If NULL, each center owns its cp
+    tStringArena* arena;
+    // Table of interned cps. If NULL, each center stores its cp
+    tPostalCodeTable* cps;
 } tHealthCenterList;
 
 
 // Initialize a center
 void center_init(tHealthCenter* center, const char* cp);
 
+// Initialize a center storing the cp on the arena. If arena is NULL the cp is allocated with malloc. If cps is not NULL, the cp refers to the interned one
+void center_initArena(tHealthCenter* center, const char* cp, tStringArena* arena, tPostalCodeTable* cps);
+
 // Release a center's data
 void center_free(tHealthCenter* center);
 
@@ -45,5 +63,8 @@ void centerList_insert(tHealthCenterList* list, const char* cp);
 // Find a center
 tHealthCenter* centerList_find(tHealthCenterList* list, const char* cp);
 
+// Find a center by the identifier of its interned cp
+tHealthCenter* centerList_findById(tHealthCenterList* list, int cpId);
+
 
 #endif // __CENTER_H__
\ No newline at end of file
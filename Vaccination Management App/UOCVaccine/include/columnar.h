@@ -0,0 +1,149 @@
+#ifndef __COLUMNAR__H
+#define __COLUMNAR__H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Magic bytes at the start of a column file
+#define COLUMN_FILE_MAGIC "UOCCOLS"
+
+// Version of the column file format
+#define COLUMN_FILE_VERSION 1
+
+// Maximum length of a column name, including the ending '\0'
+#define COLUMN_NAME_LENGTH 16
+
+// Number of values written at once
+#define COLUMN_CHUNK_VALUES 1024
+
+// Type of the values of a column
+typedef enum {
+    // 32 bits signed integers
+    COLUMN_INT32 = 1,
+    // Dictionary of strings followed by a 32 bits code for each row
+    COLUMN_DICTIONARY = 2
+} tColumnType;
+
+// Encoding of the values of a column
+typedef enum {
+    // Values are stored as they are
+    COLUMN_PLAIN = 0,
+    // The first value is stored as it is, and each other one as its difference from the previous one
+    COLUMN_DELTA = 1
+} tColumnEncoding;
+
+// Header at the start of a column file, followed by a descriptor for each column. Values use the byte order of the writer
+typedef struct _tColumnFileHeader {
+    // COLUMN_FILE_MAGIC, ending with '\0'
+    char magic[8];
+    // COLUMN_FILE_VERSION
+    uint32_t version;
+    // Number of rows of each column
+    uint32_t rows;
+    // Number of columns
+    uint32_t columns;
+    // Unused, always 0
+    uint32_t reserved;
+} tColumnFileHeader;
+
+// Position and format of a column. The data of each column starts on a multiple of 8 bytes.
+// Dictionary columns store the number of entries, the offset of each entry from the first character,
+// the entries ending with '\0', padding up to a multiple of 4 bytes and the codes
+typedef struct _tColumnDescriptor {
+    // Name of the column, ending with '\0'
+    char name[COLUMN_NAME_LENGTH];
+    // A tColumnType value
+    uint32_t type;
+    // A tColumnEncoding value
+    uint32_t encoding;
+    // Position of the data from the start of the file
+    uint64_t offset;
+    // Size of the data in bytes, without padding
+    uint64_t size;
+} tColumnDescriptor;
+
+// Column file being written
+typedef struct _tColumnFile {
+    // Output file
+    FILE* file;
+    // File header
+    tColumnFileHeader header;
+    // Column descriptors
+    tColumnDescriptor* columns;
+    // Number of started columns
+    int count;
+    // Values not written yet
+    int32_t chunk[COLUMN_CHUNK_VALUES];
+    // Number of values on the chunk
+    int chunkCount;
+    // Last added value of the current column, used by the delta encoding
+    int32_t previous;
+    // True if a write failed
+    bool error;
+} tColumnFile;
+
+// Column file loaded in memory
+typedef struct _tColumnTable {
+    // Content of the file
+    char* data;
+    // Size of the file
+    long size;
+    // File header, on data
+    const tColumnFileHeader* header;
+    // Column descriptors, on data
+    const tColumnDescriptor* columns;
+} tColumnTable;
+
+// Create a column file with the given number of rows and columns. Return false if it cannot be created
+bool columnFile_open(tColumnFile* file, const char* filename, int rows, int columns);
+
+// Start an integer column
+void columnFile_beginColumn(tColumnFile* file, const char* name, tColumnEncoding encoding);
+
+// Start a dictionary column, writing its entries. The codes of the rows are added with columnFile_putValue
+void columnFile_beginDictionary(tColumnFile* file, const char* name, char* const* entries, int count);
+
+// Add the value of the next row of the current column
+void columnFile_putValue(tColumnFile* file, int32_t value);
+
+// End the current column
+void columnFile_endColumn(tColumnFile* file);
+
+// Write the descriptors and close the file. Return false if some write failed
+bool columnFile_close(tColumnFile* file);
+
+// Load a column file in memory. Return false if it cannot be read or it is not a column file
+bool columnTable_load(tColumnTable* table, const char* filename);
+
+// Release a loaded column file
+void columnTable_free(tColumnTable* table);
+
+// Get the descriptor of a column. NULL if it does not exist
+const tColumnDescriptor* columnTable_find(const tColumnTable* table, const char* name);
+
+// Get the values of a column, or the codes of a dictionary column. Delta encoded values are returned as stored
+const int32_t* columnTable_values(const tColumnTable* table, const tColumnDescriptor* column);
+
+// Copy the decoded values of an integer column
+void columnTable_decode(const tColumnTable* table, const tColumnDescriptor* column, int32_t* values);
+
+// Get the number of entries of a dictionary column
+int columnTable_dictionaryLen(const tColumnTable* table, const tColumnDescriptor* column);
+
+// Get an entry of a dictionary column
+const char* columnTable_dictionaryEntry(const tColumnTable* table, const tColumnDescriptor* column, int code);
+
+// [AUX METHOD] Write bytes on the file
+void columnFile_write(tColumnFile* file, const void* bytes, size_t size);
+
+// [AUX METHOD] Write the values of the chunk
+void columnFile_flushChunk(tColumnFile* file);
+
+// [AUX METHOD] Add zeros up to a multiple of the given number of bytes from the start of the file
+void columnFile_pad(tColumnFile* file, int alignment);
+
+// [AUX METHOD] Start a column on the next multiple of 8 bytes
+void columnFile_startColumn(tColumnFile* file, const char* name, tColumnType type, tColumnEncoding encoding);
+
+#endif // __COLUMNAR__H
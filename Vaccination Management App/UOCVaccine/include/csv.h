@@ -2,12 +2,30 @@
 #define __CSV_H__
 
 #include <stdbool.h>
+#include "writer.h"
 #define CSV_SEPARATOR_CHAR ;
 
+// Number of entry types known by the parser
+#define CSV_NUM_TYPES 2
+// Type id of entries with a type that is not known
+#define CSV_UNKNOWN_TYPE -1
+
+// Define the entry types known by the parser
+enum _tCSVType
+{
+    CSV_TYPE_PERSON = 0, // Person
+    CSV_TYPE_VACCINE_LOT = 1, // Vaccine lot
+};
+
+// Define an entry type
+typedef enum _tCSVType tCSVType;
+
 // Store one entry from a CSV file
 typedef struct _tCSVEntry {
     int numFields;
     char* type;
+    // Id of the known type. Names of known types are shared and not owned by the entry
+    int typeId;
     char** fields;    
 } tCSVEntry;
 
@@ -36,9 +54,18 @@ void csv_print(tCSVData data);
 // Print the content of the CSV entry structure
 void csv_printEntry(tCSVEntry entry);
 
+// Write the content of the CSV data structure with the format of csv_print
+void csv_write(tCSVData data, tReportWriter* writer);
+
+// Write the content of the CSV entry structure with the format of csv_printEntry
+void csv_writeEntry(tCSVEntry entry, tReportWriter* writer);
+
 // Parse the contents of a CSV line   "f1;f2;f3" =>  field_0 = f1, field_1 = f2, field_2 = f3
 void csv_parseEntry(tCSVEntry* entry, const char* input, const char* type);
 
+// Split a CSV line in place, replacing separators by '\0'. Store up to maxFields pointers to the fields and return the number of fields
+int csv_splitLine(char* line, char** fields, int maxFields);
+
 // Get the number of entries
 bool csv_isValid(tCSVData data);
 
@@ -54,6 +81,21 @@ int csv_numEntries(tCSVData data);
 // Get the type of information contained in the entry
 const char* csv_getType(tCSVEntry* entry);
 
+// Get the id of the type of the entry. CSV_UNKNOWN_TYPE if the type is not known
+int csv_getTypeId(tCSVEntry* entry);
+
+// Get the id of a known type. CSV_UNKNOWN_TYPE if it is not known
+int csv_findType(const char* type);
+
+// Get the name of a known type
+const char* csv_typeName(int typeId);
+
+// [AUX METHOD] Get the id of a known type given by its first length characters
+int csv_findTypeLength(const char* type, int length);
+
+// [AUX METHOD] Set the type of an entry given by its first length characters
+void csv_setType(tCSVEntry* entry, const char* type, int length);
+
 // Get an entry from the CSV data
 tCSVEntry* csv_getEntry(tCSVData data, int position);
 
@@ -69,6 +111,12 @@ void csv_getAsString(tCSVEntry entry, int position, char* buffer, int length);
 // Get a field from the given entry as integer
 float csv_getAsReal(tCSVEntry entry, int position);
 
+// Parse a decimal integer. Return false if the text is not a valid integer
+bool csv_parseInteger(const char* str, int* value);
+
+// Parse a decimal real number using '.' as decimal separator. Return false if the text is not a valid number
+bool csv_parseReal(const char* str, float* value);
+
 // Compare if two entries are the same
 bool csv_equalsEntry(tCSVEntry entry1, tCSVEntry entry2);
 
@@ -0,0 +1,86 @@
+#ifndef __CURSOR__H
+#define __CURSOR__H
+
+#include "vaccine.h"
+#include "person.h"
+#include "appointment.h"
+
+// Cursor over the vaccines, in name order. Vaccines inserted after the last returned name are returned too
+typedef struct _tVaccineCursor {
+    // Vaccine list. NULL once the cursor is closed
+    tVaccineList* list;
+    // Copy of the name of the last returned vaccine. NULL before the first batch
+    char* last;
+} tVaccineCursor;
+
+// Cursor over the vaccine lots. Lots added after the cursor is opened are not returned
+typedef struct _tLotCursor {
+    // Lots table. NULL once the cursor is closed
+    tVaccineLotData* data;
+    // Position of the next lot
+    int pos;
+    // Number of lots when the cursor was opened
+    int end;
+} tLotCursor;
+
+// Cursor over the population. Persons added after the cursor is opened are not returned
+typedef struct _tPopulationCursor {
+    // Population. NULL once the cursor is closed
+    tPopulation* data;
+    // Position of the next person
+    int pos;
+    // Number of persons when the cursor was opened
+    int end;
+} tPopulationCursor;
+
+// Cursor over the doses of a range of dose series. Series booked after the cursor is opened are not returned
+typedef struct _tAppointmentCursor {
+    // Dose series list. NULL once the cursor is closed
+    tDoseSeriesData* list;
+    // Population with the persons of the series
+    tPopulation* population;
+    // Position of the current series
+    int series;
+    // Next dose of the current series
+    int dose;
+    // Position after the last series
+    int end;
+} tAppointmentCursor;
+
+// Open a cursor over a vaccine list
+void vaccineCursor_open(tVaccineCursor* cursor, tVaccineList* list);
+
+// Copy the next vaccines to the array, up to n. Names refer to the list. Return the number of copied vaccines, 0 at the end
+int vaccineCursor_next(tVaccineCursor* cursor, tVaccine* vaccines, int n);
+
+// Close the cursor and release its data
+void vaccineCursor_close(tVaccineCursor* cursor);
+
+// Open a cursor over a lots table
+void lotCursor_open(tLotCursor* cursor, tVaccineLotData* data);
+
+// Copy the next lots to the array, up to n. Cps and vaccines refer to the table. Return the number of copied lots, 0 at the end
+int lotCursor_next(tLotCursor* cursor, tVaccineLot* lots, int n);
+
+// Close the cursor
+void lotCursor_close(tLotCursor* cursor);
+
+// Open a cursor over a population
+void populationCursor_open(tPopulationCursor* cursor, tPopulation* data);
+
+// Copy the next persons to the array, up to n. Text fields refer to the population. Return the number of copied persons, 0 at the end
+int populationCursor_next(tPopulationCursor* cursor, tPerson* persons, int n);
+
+// Close the cursor
+void populationCursor_close(tPopulationCursor* cursor);
+
+// Open a cursor over the series of a list on the range [first, end), with the persons of the population. If list is NULL the cursor is empty
+void appointmentCursor_open(tAppointmentCursor* cursor, tDoseSeriesData* list, tPopulation* population, int first, int end);
+
+// Store on the array the next appointments, up to n. Persons refer to the population. Return the number of stored appointments, 0 at the end
+int appointmentCursor_next(tAppointmentCursor* cursor, tAppointment* appointments, int n);
+
+// Close the cursor
+void appointmentCursor_close(tAppointmentCursor* cursor);
+
+#endif // __CURSOR__H
@@ -1,8 +1,15 @@
 #ifndef __DATE_H__
 #define __DATE_H__
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
 
+// Day number of 01/01/1900, the origin of packed tDateTime keys
+#define DATETIME_KEY_EPOCH_DAYS -25567
+
+// First year accepted by date_parse, so all the parsed dates have a packed key
+#define DATE_MIN_YEAR 1900
+
 typedef struct _tDate {    
     int day; 
     int month;
@@ -19,9 +26,12 @@ typedef struct _tDateTime {
     tTime time;    
 } tDateTime;
 
+// Packed tDateTime: minutes elapsed from 01/01/1900 00:00. Keys compare as their tDateTime
+typedef uint32_t tDateTimeKey;
+
 
-// Parse a tDateTime from string information
-void dateTime_parse(tDateTime* dateTime, const char* date, const char* time);
+// Parse a tDateTime from "DD/MM/YYYY" and "HH:MM" strings. Return false if any of them is malformed
+bool dateTime_parse(tDateTime* dateTime, const char* date, const char* time);
 
 // Compare two tDateTime structures and return -1 if dateTime1<dateTime2, 0 if equals and 1 if dateTime1>dateTime2.
 int dateTime_cmp(tDateTime dateTime1, tDateTime dateTime2);
@@ -38,8 +48,23 @@ void dateTime_initTime(struct tm *std_time, tDateTime timestamp);
 // Add days to a given datetime
 void dateTime_addDay(tDateTime* dateTime, int days);
 
-// Parse a tDate from string information
-void date_parse(tDate* date, const char* str);
+// Get the packed key of a tDateTime. Dates must not be before 01/01/1900
+tDateTimeKey dateTime_toKey(tDateTime dateTime);
+
+// Initialize a tDateTime from its packed key
+void dateTime_fromKey(tDateTime* dateTime, tDateTimeKey key);
+
+// Parse a tDate from a "DD/MM/YYYY" string. Return false if it is malformed or the year is before DATE_MIN_YEAR
+bool date_parse(tDate* date, const char* str);
+
+// Parse a tTime from a "HH:MM" string. Return false if it is malformed
+bool time_parse(tTime* time, const char* str);
+
+// Get the number of days of a month
+int date_daysInMonth(int month, int year);
+
+// [AUX METHOD] Get the value of a fixed number of digits. Return -1 if any of the characters is not a digit
+int date_parseDigits(const char* str, int length);
 
 // Compare two tDate structures and return -1 if date1<date2, 0 if equals and 1 if date1>date2.
 int date_cmp(tDate date1, tDate date2);
@@ -47,4 +72,13 @@ int date_cmp(tDate date1, tDate date2);
 // Add days to a given date
 void date_addDay(tDate* date, int days);
 
+// Get the day number of a given date, counted in days from 01/01/1970
+int date_toDays(tDate date);
+
+// Initialize a date from its day number, counted in days from 01/01/1970
+void date_fromDays(tDate* date, int days);
+
+// Get the number of days from date1 to date2
+int date_diffDays(tDate date1, tDate date2);
+
 #endif // __DATE_H__
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef __DOCUMENT__H
+#define __DOCUMENT__H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Packed identity document: kind, number and check letter
+typedef uint64_t tDocumentKey;
+
+// Key of the documents that are not a DNI or NIE. They are compared as strings
+#define DOCUMENT_KEY_NONE 0
+
+// Letters used as check digit of DNI and NIE numbers
+#define DOCUMENT_CHECK_LETTERS "TRWAGMYFPDXBNJZSQVHLCKE"
+
+// Get the packed key of a DNI (8 digits and letter) or NIE (X, Y or Z, 7 digits and letter). DOCUMENT_KEY_NONE for other documents
+tDocumentKey document_toKey(const char* document);
+
+// Check if the letter of a DNI or NIE matches its number
+bool document_isValid(const char* document);
+
+// Check if two documents are equal, comparing their keys when they are packed
+bool document_equals(tDocumentKey keyA, const char* documentA, tDocumentKey keyB, const char* documentB);
+
+// Compare two documents with the same order than strcmp, comparing their keys when they are packed
+int document_cmp(tDocumentKey keyA, const char* documentA, tDocumentKey keyB, const char* documentB);
+
+// Get a hash value of a document
+uint32_t document_hash(tDocumentKey key, const char* document);
+
+#endif // __DOCUMENT__H
@@ -16,6 +16,9 @@ enum _tApiError
     E_HEALTH_CENTER_NOT_FOUND = -9, // Health Center not found
     E_LOT_NOT_FOUND = -10, // Vaccine lot not found
     E_NO_VACCINES = -11, // No vaccines to allocate appointments.
+    E_INVALID_DOCUMENT = -12, // Document check letter does not match its number
+    E_APPOINTMENT_NOT_FOUND = -13, // Person without vaccination appointments
+    E_HOLD_NOT_FOUND = -14, // Hold not found, or already confirmed, released or expired
 };
 
 // Define an error type
@@ -0,0 +1,74 @@
+#ifndef __HOLD__H
+#define __HOLD__H
+
+#include <stdbool.h>
+#include "date.h"
+#include "center.h"
+
+// Number of levels of the timing wheel
+#define HOLD_WHEEL_LEVELS 4
+
+// Number of bits of the minutes used on each level
+#define HOLD_WHEEL_BITS 6
+
+// Number of slots of each level
+#define HOLD_WHEEL_SLOTS (1 << HOLD_WHEEL_BITS)
+
+// Stock reserved for the doses of a person while the booking is confirmed
+typedef struct _tHold {
+    // Center with the reserved stock
+    tHealthCenter* center;
+    // Reserved doses
+    tDoseSeries series;
+    // Packed timestamp when the hold expires
+    tDateTimeKey expiry;
+    // False once the hold is confirmed, released or expired
+    bool active;
+    // Next hold on the same slot of the wheel. -1 for the last one
+    int next;
+} tHold;
+
+// Function called for each expired hold
+typedef void (*tHoldVisitor)(tHold* hold, void* context);
+
+// Holds sorted by expiry on a hierarchical timing wheel. Each level covers HOLD_WHEEL_SLOTS times the minutes of the previous one
+typedef struct _tHoldWheel {
+    // Holds, indexed by their identifier
+    tHold* elems;
+    // Number of holds
+    int count;
+    // Number of allocated holds
+    int capacity;
+    // Number of active holds
+    int active;
+    // First hold of each slot. -1 for empty slots. Released holds are removed when their slot is processed
+    int slots[HOLD_WHEEL_LEVELS][HOLD_WHEEL_SLOTS];
+    // Packed timestamp of the last processed minute
+    tDateTimeKey current;
+} tHoldWheel;
+
+// Initialize an empty wheel
+void holdWheel_init(tHoldWheel* wheel);
+
+// Release the wheel data
+void holdWheel_free(tHoldWheel* wheel);
+
+// Add a hold expiring at the given timestamp, before HOLD_WHEEL_SLOTS^HOLD_WHEEL_LEVELS minutes from the last processed one. Return its identifier
+int holdWheel_add(tHoldWheel* wheel, tHealthCenter* center, tDoseSeries series, tDateTime expiry);
+
+// Get an active hold. NULL if it does not exist or it is not active
+tHold* holdWheel_get(tHoldWheel* wheel, int id);
+
+// Mark a hold as not active
+void holdWheel_remove(tHoldWheel* wheel, int id);
+
+// Process all the minutes up to the given timestamp, calling the visitor for each expired hold before removing it. Return the number of expired holds
+int holdWheel_advance(tHoldWheel* wheel, tDateTime now, tHoldVisitor visitor, void* context);
+
+// [AUX METHOD] Add a hold to the slot for its expiry
+void holdWheel_insert(tHoldWheel* wheel, int id);
+
+// [AUX METHOD] Move the holds of the current slot of a level to the lower levels
+void holdWheel_cascade(tHoldWheel* wheel, int level);
+
+#endif // __HOLD__H
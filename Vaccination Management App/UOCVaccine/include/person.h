@@ -2,20 +2,103 @@
 #define __PERSON_H__
 #include "csv.h"
 #include "date.h"
+#include "arena.h"
+#include "postalcode.h"
+#include "document.h"
+#include <stdint.h>
+#include "bitmap.h"
 
+// Initial number of positions of the population hash table
+#define POPULATION_INDEX_SIZE 64
+
+// Data of a person used on searches and scheduling
 typedef struct _tPerson {
     char* document;
+    // Packed document, compared before the string
+    tDocumentKey key;
+    char* cp;
+    tDate birthday;
+    // Identifier of the cp on the postal code table. POSTAL_CODE_UNKNOWN if it is not interned
+    int cpId;
+} tPerson;
+
+// Contact data of a person, only used to print and export it
+typedef struct _tPersonContact {
     char* name;
     char* surname;
-    char* cp;
     char* email;
     char* address;
-    tDate birthday;
-} tPerson;
+} tPersonContact;
+
+// Persons with appointments for a vaccine
+typedef struct _tVaccinePersons {
+    // Name of the vaccine
+    char* vaccine;
+    // Positions of the persons
+    tBitmap persons;
+} tVaccinePersons;
+
+// Booking state of a person
+typedef struct _tPersonBooking {
+    // Identifier of the cp of the center with the appointments
+    int centerId;
+    // Position of the dose series on the center
+    int series;
+    // Number of booked doses. 0 if the person has no appointments
+    int doses;
+    // Identifier of the cp of the center where the person is waiting for vaccines. POSTAL_CODE_UNKNOWN if it is not waiting
+    int waitingId;
+    // Identifier of the active hold of the person. -1 if it has none
+    int hold;
+} tPersonBooking;
+
+// Entry of the birthday index
+typedef struct _tBirthdayEntry {
+    // Birthday as number of days
+    int days;
+    // Position of the person
+    int pos;
+} tBirthdayEntry;
+
+// Function called for each person of a query
+typedef void (*tPersonVisitor)(tPerson* person, void* context);
+
+// Data of a visit to the persons of a set of positions
+typedef struct _tPopulationVisit {
+    tPerson* elems;
+    tPersonVisitor visitor;
+    void* context;
+} tPopulationVisit;
 
 typedef struct _tPopulation {
     tPerson* elems;
+    // Contact data, on the same position than the person
+    tPersonContact* contacts;
     int count;
+    // Storage of the text fields. If NULL, each person owns its strings
+    tStringArena* arena;
+    // Table of interned cps. If NULL, each person stores its cp
+    tPostalCodeTable* cps;
+    // Hash table with the position of each person. -1 on empty positions
+    int* index;
+    // Number of positions of the hash table
+    int indexSize;
+    // Positions of the persons of each interned cp, indexed by cp identifier. Only used with a table of interned cps
+    tBitmap* byCp;
+    // Number of sets of persons by cp
+    int byCpCount;
+    // Positions of the persons with appointments
+    tBitmap scheduled;
+    // Booking state, on the same position than the person
+    tPersonBooking* bookings;
+    // Persons with appointments of each vaccine
+    tVaccinePersons* byVaccine;
+    // Number of sets of persons by vaccine
+    int byVaccineCount;
+    // Persons sorted by birthday and position
+    tBirthdayEntry* byBirthday;
+    // If false, the birthday index is sorted again on the next query
+    bool byBirthdaySorted;
 } tPopulation;
 
 // Initialize the population data
@@ -30,13 +113,28 @@ void person_free(tPerson* data);
 // Remove the data from all persons
 void population_free(tPopulation* data);
 
-// Parse input from CSVEntry
-void person_parse(tPerson* data, tCSVEntry entry);
+// Parse input from CSVEntry, storing the contact data on contact. Return false if the entry is malformed
+bool person_parse(tPerson* data, tPersonContact* contact, tCSVEntry entry);
+
+// Parse the 7 fields of a person without copying them. Person and contact refer to the fields and must not be released. Contact can be NULL
+bool person_parseView(tPerson* data, tPersonContact* contact, char** fields);
+
+// Initialize a person contact structure
+void personContact_init(tPersonContact* data);
 
-// Add a new person
-void population_add(tPopulation* data, tPerson person);
+// Remove the data from a person contact
+void personContact_free(tPersonContact* data);
 
-// Remove a person
+// Copy the data from the source to an empty destination, storing the strings on the arena. If arena is NULL they are allocated with malloc
+void personContact_cpyArena(tPersonContact* destination, tPersonContact source, tStringArena* arena);
+
+// Add a new person with its contact data
+void population_add(tPopulation* data, tPerson person, tPersonContact contact);
+
+// Get the contact data of the person on the given position
+tPersonContact* population_getContact(tPopulation* data, int pos);
+
+// Remove a person. Positions stored on the centers are not updated, use api_deletePerson on the application data
 void population_del(tPopulation* data, const char *document);
 
 // Return the position of a person with provided document. -1 if it does not exist
@@ -45,10 +143,79 @@ int population_find(tPopulation data, const char* document);
 // Print the person data
 void population_print(tPopulation data);
 
+// Write the person data with the format of population_print
+void population_write(tPopulation data, tReportWriter* writer);
+
 // Copy the data from the source to destination
 void person_cpy(tPerson* destination, tPerson source);
 
+// Copy the data from the source to an empty destination, storing the strings on the arena. If arena is NULL they are allocated with malloc. If cps is not NULL, the cp refers to the interned one
+void person_cpyArena(tPerson* destination, tPerson source, tStringArena* arena, tPostalCodeTable* cps);
+
 // Return population lenght
 int population_len(tPopulation data);
 
+// Call the visitor for each person with the given interned cp. Return the number of visited persons
+int population_visitCp(tPopulation* data, int cpId, tPersonVisitor visitor, void* context);
+
+// Call the visitor for each person on the set of positions. Return the number of visited persons
+int population_visitSet(tPopulation* data, const tBitmap* persons, tPersonVisitor visitor, void* context);
+
+// Get the positions of the persons with the given interned cp. NULL if there are none
+const tBitmap* population_getCpSet(tPopulation* data, int cpId);
+
+// Store on result the positions of the persons born before the cutoff. Result must be initialized and is replaced
+void population_getBornBefore(tPopulation* data, tDate cutoff, tBitmap* result);
+
+// Get the positions of the persons with appointments for the given vaccine, or any vaccine if it is NULL. NULL if there are none
+const tBitmap* population_getScheduledSet(tPopulation* data, const char* vaccine);
+
+// Mark the person on the given position as scheduled or not. Unscheduled persons are removed from all the vaccine sets
+void population_setScheduled(tPopulation* data, int pos, bool scheduled);
+
+// Mark the person on the given position as scheduled for a vaccine
+void population_setScheduledVaccine(tPopulation* data, int pos, const char* vaccine);
+
+// Check if the person on the given position has appointments
+bool population_isScheduled(tPopulation* data, int pos);
+
+// Set the center where the person on the given position is waiting for vaccines
+void population_setWaiting(tPopulation* data, int pos, int centerId);
+
+// Store the booking of the person on the given position and mark it as scheduled for the vaccine. The person stops waiting
+void population_setBooking(tPopulation* data, int pos, int centerId, int series, const char* vaccine, int doses);
+
+// Set the active hold of the person on the given position. -1 if it has none
+void population_setHold(tPopulation* data, int pos, int hold);
+
+// Get the booking state of the person on the given position
+const tPersonBooking* population_getBooking(tPopulation* data, int pos);
+
+// Check if the person on the given position is booked in any center
+bool population_isBooked(tPopulation* data, int pos);
+
+// Call the visitor for each person without appointments born before the cutoff, from the oldest one. If cpId is not POSTAL_CODE_UNKNOWN only persons on this cp are visited. Return the number of visited persons
+int population_visitEligible(tPopulation* data, tDate cutoff, int cpId, tPersonVisitor visitor, void* context);
+
+// [AUX METHOD] Remove the booking of the person on the given position and mark it as not scheduled. Bookings are cancelled with api_cancelAppointment, which also releases the series
+void population_clearBooking(tPopulation* data, int pos);
+
+// [AUX METHOD] Sort the birthday index
+void population_birthdayIndexBuild(tPopulation* data);
+
+// [AUX METHOD] Compare two entries of the birthday index
+int population_birthdayCmp(const void* a, const void* b);
+
+// [AUX METHOD] Add the person on the given position to the set of its cp
+void population_cpIndexAdd(tPopulation* data, int pos);
+
+// [AUX METHOD] Call the person visitor of a population visit for a position
+void population_visitPosition(uint32_t pos, void* context);
+
+// [AUX METHOD] Add the person on the given position to the hash table, growing it if needed
+void population_indexAdd(tPopulation* data, int pos);
+
+// [AUX METHOD] Create again the hash table with the given number of positions
+void population_indexBuild(tPopulation* data, int size);
+
 #endif
@@ -0,0 +1,51 @@
+#ifndef __POSTALCODE__H
+#define __POSTALCODE__H
+
+#include <stdbool.h>
+#include "arena.h"
+
+// Identifier of a postal code that is not in the table
+#define POSTAL_CODE_UNKNOWN -1
+
+// Initial number of positions of the postal code hash table
+#define POSTAL_CODE_TABLE_SIZE 64
+
+// Table of distinct postal codes, each one with a dense identifier
+typedef struct _tPostalCodeTable {
+    // Canonical strings, indexed by identifier
+    char** codes;
+    // Number of postal codes
+    int count;
+    // Hash table with the identifiers. POSTAL_CODE_UNKNOWN on empty positions
+    int* slots;
+    // Number of positions of the hash table
+    int size;
+    // Storage of the canonical strings. If NULL, they are allocated with malloc
+    tStringArena* arena;
+} tPostalCodeTable;
+
+// Initialize the table. The canonical strings are stored on the arena, if any
+void postalCodeTable_init(tPostalCodeTable* table, tStringArena* arena);
+
+// Release the table data
+void postalCodeTable_free(tPostalCodeTable* table);
+
+// Get the identifier of a postal code. POSTAL_CODE_UNKNOWN if it is not in the table
+int postalCodeTable_find(tPostalCodeTable* table, const char* cp);
+
+// Get the identifier of a postal code, adding it if it is not in the table
+int postalCodeTable_intern(tPostalCodeTable* table, const char* cp);
+
+// Get the canonical string of a postal code identifier
+const char* postalCodeTable_get(tPostalCodeTable* table, int id);
+
+// Get the number of postal codes
+int postalCodeTable_len(tPostalCodeTable* table);
+
+// [AUX METHOD] Get the position of the hash table for a postal code, empty or holding its identifier
+int postalCodeTable_slot(tPostalCodeTable* table, const char* cp);
+
+// [AUX METHOD] Double the size of the hash table
+void postalCodeTable_grow(tPostalCodeTable* table);
+
+#endif // __POSTALCODE__H
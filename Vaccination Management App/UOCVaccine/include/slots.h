@@ -0,0 +1,72 @@
+#ifndef __SLOTS__H
+#define __SLOTS__H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "date.h"
+
+// Minutes of each appointment slot
+#define SLOT_MINUTES 15
+
+// Number of slots of a day
+#define SLOTS_PER_DAY (24 * 60 / SLOT_MINUTES)
+
+// Number of words of the bitmaps of a day
+#define SLOT_WORDS ((SLOTS_PER_DAY + 63) / 64)
+
+// Value returned when there is no free slot
+#define SLOT_NOT_FOUND -1
+
+// Appointments of each slot of a day
+typedef struct _tSlotDay {
+    // Number of appointments of each slot
+    uint16_t used[SLOTS_PER_DAY];
+    // One bit for each slot that reached the capacity
+    uint64_t full[SLOT_WORDS];
+} tSlotDay;
+
+// Appointments by slot of a center
+typedef struct _tSlotCalendar {
+    // Appointments per slot. 0 if there is no limit
+    int capacity;
+    // One bit for each slot on the opening hours
+    uint64_t open[SLOT_WORDS];
+    // Day number of the first day
+    int firstDay;
+    // Days from the first one. Days out of the range have no appointments
+    tSlotDay* days;
+    // Number of days
+    int count;
+} tSlotCalendar;
+
+// Initialize a calendar without limit
+void slotCalendar_init(tSlotCalendar* calendar);
+
+// Release the calendar data
+void slotCalendar_free(tSlotCalendar* calendar);
+
+// Set the appointments per slot and the opening hours, from the open time to the slot before the close time. A capacity of 0 removes the limit
+void slotCalendar_setCapacity(tSlotCalendar* calendar, int capacity, tTime open, tTime close);
+
+// Add appointments to the slot of a timestamp. Negative values remove them
+void slotCalendar_update(tSlotCalendar* calendar, tDateTime timestamp, int appointments);
+
+// Get the number of appointments on the slot of a timestamp
+int slotCalendar_getUsed(tSlotCalendar* calendar, tDateTime timestamp);
+
+// Get the first open slot not before the given one that is free on the day and the following doses. SLOT_NOT_FOUND if there is none
+int slotCalendar_findFirst(tSlotCalendar* calendar, int day, int interval, int doses, int slot);
+
+// Get the slot of a time
+int slot_fromTime(tTime time);
+
+// Get the start time of a slot
+tTime slot_toTime(int slot);
+
+// [AUX METHOD] Get a day of the calendar, adding it if create is true. NULL if it does not exist
+tSlotDay* slotCalendar_getDay(tSlotCalendar* calendar, int day, bool create);
+
+// [AUX METHOD] Update the bit of a slot on the full bitmap
+void slotCalendar_updateFull(tSlotCalendar* calendar, tSlotDay* day, int slot);
+
+#endif // __SLOTS__H
@@ -3,6 +3,8 @@
 
 #include "vaccine.h"
 #include "date.h"
+#include "timeline.h"
+#include "writer.h"
 
 // Vaccine stock
 typedef struct _tVaccineStock {
@@ -29,13 +31,23 @@ typedef struct _tVaccineStockData {
     tVaccineDailyStock* first;
     tVaccineDailyStock* last;
     int count;
+    // Nodes of the daily list by their distance in days to the first node
+    tVaccineDailyStock** days;
+    // Incremented on every modification of the stock
+    int epoch;
+    // Doses of each vaccine by day. Always up to date
+    tStockTimeline* timelines;
+    // Number of timelines
+    int timelineCount;
+    // If true, the daily list must be rebuilt from the timelines before reading it
+    bool stale;
 } tVaccineStockData;
 
 
 // Initialize a stock list
 void stockList_init(tVaccineStockData* list);
 
-// Modify the doses of a certain vaccine
+// Modify the doses of a certain vaccine. If the daily list is not up to date only the timeline is modified
 void stockList_update(tVaccineStockData* list, tDate date, tVaccine* vaccine, int doses);
 
 // Get the number of doses for a certain vaccine and date
@@ -47,6 +59,21 @@ void stockList_free(tVaccineStockData* list);
 // Print stock list
 void stockList_print(tVaccineStockData list);
 
+// Write the stock list with the format of stockList_print
+void stockList_write(tVaccineStockData list, tReportWriter* writer);
+
+// Modify the doses of a certain vaccine only on its timeline. The daily list is rebuilt when it is read again
+void stockList_adjust(tVaccineStockData* list, tDate date, tVaccine* vaccine, int doses);
+
+// Rebuild the daily list from the timelines if it is not up to date. Only needed before reading the daily list
+void stockList_sync(tVaccineStockData* list);
+
+// Get the first date not before the given one with at least the given doses of a vaccine. Return false if there is none
+bool stockList_findFirst(tVaccineStockData* list, tDate date, tVaccine* vaccine, int doses, tDate* first);
+
+// Get the first date not before the given one where the given number of persons can receive all the doses of a vaccine. Return false if there is none
+bool stockList_findFirstSeries(tVaccineStockData* list, tDate date, tVaccine* vaccine, int persons, tDate* first);
+
 
 ///// AUX Methods: Top-down design //////
 
@@ -89,4 +116,10 @@ void stockList_expandRight(tVaccineStockData* list, tDate date);
 // Remove entries with no data on the start and end of the list
 void stockList_purge(tVaccineStockData* list);
 
+// Rebuild the index of the daily nodes after the list has been modified
+void stockList_index(tVaccineStockData* list);
+
+// Get the timeline of a vaccine. If it does not exist and create is true it is added, otherwise NULL is returned
+tStockTimeline* stockList_getTimeline(tVaccineStockData* list, tVaccine* vaccine, bool create);
+
 #endif // __STOCK__H
\ No newline at end of file
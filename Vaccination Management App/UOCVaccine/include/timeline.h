@@ -0,0 +1,58 @@
+#ifndef __TIMELINE__H
+#define __TIMELINE__H
+
+#include <stdbool.h>
+#include "vaccine.h"
+#include "date.h"
+
+// Initial number of days of a timeline
+#define TIMELINE_INITIAL_DAYS 64
+
+// Value returned when there is no day with enough doses
+#define TIMELINE_NOT_FOUND -1
+
+// Doses of a vaccine by day, stored as a segment tree with pending additions
+typedef struct _tStockTimeline {
+    // Vaccine
+    tVaccine* vaccine;
+    // Day number of the first leaf
+    int firstDay;
+    // Number of leaves. Power of two, 0 for an empty timeline
+    int size;
+    // Maximum number of doses on the days of each node, including its own pending addition
+    int* max;
+    // Doses added to all the days of each node
+    int* add;
+} tStockTimeline;
+
+// Initialize an empty timeline for a vaccine
+void timeline_init(tStockTimeline* timeline, tVaccine* vaccine);
+
+// Release the timeline data
+void timeline_free(tStockTimeline* timeline);
+
+// Add doses to the given day and all the following ones. Days after the last leaf have the doses of the last leaf
+void timeline_update(tStockTimeline* timeline, int day, int doses);
+
+// Get the number of doses on the given day
+int timeline_getDoses(tStockTimeline* timeline, int day);
+
+// Get the first day not before the given one with at least the given number of doses. TIMELINE_NOT_FOUND if there is none
+int timeline_findFirst(tStockTimeline* timeline, int day, int doses);
+
+// Store on doses the number of doses of the given count of days from the given one
+void timeline_getRange(tStockTimeline* timeline, int day, int count, int* doses);
+
+// [AUX METHOD] Add doses to the days of the node on the range [start, end)
+void timeline_addRange(tStockTimeline* timeline, int node, int nodeStart, int nodeEnd, int start, int end, int doses);
+
+// [AUX METHOD] Search the first leaf from the given position with at least the given number of doses
+int timeline_descend(tStockTimeline* timeline, int node, int nodeStart, int nodeEnd, int from, int doses, int pending);
+
+// [AUX METHOD] Store on doses the number of doses of the leaves of the node on the range [start, end), from the position of start
+void timeline_collect(tStockTimeline* timeline, int node, int nodeStart, int nodeEnd, int start, int end, int pending, int* doses);
+
+// [AUX METHOD] Grow the timeline to include the given day
+void timeline_grow(tStockTimeline* timeline, int day);
+
+#endif // __TIMELINE__H
@@ -3,6 +3,8 @@
 
 #include "csv.h"
 #include "date.h"
+#include "arena.h"
+#include "postalcode.h"
 
 // Vaccine data
 typedef struct _tVaccine {
@@ -27,7 +29,11 @@ typedef struct _tVaccineList {
 typedef struct _tVaccineLot {
     tVaccine* vaccine;
     tDateTime timestamp;
+    // Packed timestamp, compared first on searches
+    tDateTimeKey key;
     char *cp;
+    // Identifier of the cp on the postal code table. POSTAL_CODE_UNKNOWN if it is not interned
+    int cpId;
     int doses;
 } tVaccineLot;
 
@@ -35,8 +41,18 @@ typedef struct _tVaccineLot {
 typedef struct _tVaccineLotData {    
     tVaccineLot* elems;
     int count;
+    // Storage of the lot cps. If NULL, each lot owns its cp
+    tStringArena* arena;
+    // Table of interned cps. If NULL, each lot stores its cp
+    tPostalCodeTable* cps;
 } tVaccineLotData;
 
+// Function called for each vaccine of a query
+typedef void (*tVaccineVisitor)(const tVaccine* vaccine, void* context);
+
+// Function called for each vaccine lot of a query
+typedef void (*tVaccineLotVisitor)(const tVaccineLot* lot, void* context);
+
 
 
 // Initialize vaccine structure
@@ -53,14 +69,20 @@ void vaccine_cpy(tVaccine* destination, tVaccine source);
 // Release vaccine lot data
 void vaccineLot_init(tVaccineLot* lot, tVaccine* vaccine, const char* cp, tDateTime timestamp, int doses);
 
+// Initialize a vaccine lot storing the cp on the arena. If arena is NULL the cp is allocated with malloc. If cps is not NULL, the cp refers to the interned one
+void vaccineLot_initArena(tVaccineLot* lot, tVaccine* vaccine, const char* cp, tDateTime timestamp, int doses, tStringArena* arena, tPostalCodeTable* cps);
+
 // Release vaccine lot data
 void vaccineLot_free(tVaccineLot* lot);
 
 // Copy the data of a vaccine lot from the source to destination
 void vaccineLot_cpy(tVaccineLot* destination, tVaccineLot source);
 
-// Parse input from CSVEntry
-void vaccineLot_parse(tVaccine* vaccine, tVaccineLot* lot, tCSVEntry entry);
+// Parse input from CSVEntry. Return false if the entry is malformed
+bool vaccineLot_parse(tVaccine* vaccine, tVaccineLot* lot, tCSVEntry entry);
+
+// Parse the 7 fields of a lot without copying them. Vaccine and lot refer to the fields and must not be released
+bool vaccineLot_parseView(tVaccine* vaccine, tVaccineLot* lot, char** fields);
 
 
 
@@ -82,6 +104,9 @@ void vaccineList_insert(tVaccineList* list, tVaccine vaccine);
 // Remove a vaccine
 void vaccineList_del(tVaccineList* list, const char* vaccine);
 
+// Call the visitor for each vaccine, in list order. Return the number of visited vaccines
+int vaccineList_visit(tVaccineList list, tVaccineVisitor visitor, void* context);
+
 
 
 // Initialize the vaccine lots data
@@ -102,5 +127,8 @@ void vaccineLotData_del(tVaccineLotData* data, const char* cp, const char* vacci
 // Return the position of a vaccine lot entry with provided information. -1 if it does not exist
 int vaccineLotData_find(tVaccineLotData data, const char* cp, const char* vaccine, tDateTime timestamp);
 
+// Call the visitor for each vaccine lot, in table order. Return the number of visited lots
+int vaccineLotData_visit(tVaccineLotData data, tVaccineLotVisitor visitor, void* context);
+
 
 #endif // __VACCINE__H
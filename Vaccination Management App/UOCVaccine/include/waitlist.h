@@ -0,0 +1,57 @@
+#ifndef __WAITLIST__H
+#define __WAITLIST__H
+
+#include <stdbool.h>
+#include "date.h"
+#include "person.h"
+
+// Request of a person waiting for vaccines on a center
+typedef struct _tWaitlistEntry {
+    // Position of the person on the population. Positions are kept when the population grows and updated by api_deletePerson
+    int person;
+    // Birthday of the person as number of days. Older persons are served first
+    int birthday;
+    // Requested timestamp of the first dose
+    tDateTime timestamp;
+    // Packed requested timestamp, used to break ties between persons born the same day
+    tDateTimeKey key;
+} tWaitlistEntry;
+
+// Priority queue of requests, stored as a binary heap
+typedef struct _tWaitlist {
+    // Entries. The first one has the highest priority
+    tWaitlistEntry* elems;
+    // Number of entries
+    int count;
+    // Number of allocated entries
+    int capacity;
+} tWaitlist;
+
+// Initialize an empty waitlist
+void waitlist_init(tWaitlist* list);
+
+// Release the waitlist data
+void waitlist_free(tWaitlist* list);
+
+// Add the request of the person on the given position, with its birthday
+void waitlist_push(tWaitlist* list, int person, tDate birthday, tDateTime timestamp);
+
+// Remove the request with the highest priority. Return false if the waitlist is empty
+bool waitlist_pop(tWaitlist* list, tWaitlistEntry* entry);
+
+// Remove the requests of the person on the given position after it is removed from the population. The next persons move one position down
+void waitlist_delPerson(tWaitlist* list, int person);
+
+// Get the number of requests
+int waitlist_len(tWaitlist list);
+
+// [AUX METHOD] Check if the first entry has higher priority than the second one
+bool waitlist_before(tWaitlistEntry* a, tWaitlistEntry* b);
+
+// [AUX METHOD] Move the entry on the given position up to its place
+void waitlist_siftUp(tWaitlist* list, int pos);
+
+// [AUX METHOD] Move the entry on the given position down to its place
+void waitlist_siftDown(tWaitlist* list, int pos);
+
+#endif // __WAITLIST__H
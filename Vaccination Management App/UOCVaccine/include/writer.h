@@ -0,0 +1,94 @@
+#ifndef __WRITER__H
+#define __WRITER__H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "date.h"
+
+// Size of the output buffer of a report writer
+#define WRITER_BUFFER_SIZE 65536
+
+// Format of the records written by the emitters
+typedef enum {
+    // Fields separated by ';', starting with the record type
+    REPORT_CSV,
+    // One JSON object per line, with the record type on the "type" member
+    REPORT_JSON
+} tReportFormat;
+
+// Buffered output of reports to a file or a file descriptor
+typedef struct _tReportWriter {
+    // Output buffer
+    char* buffer;
+    // Number of used bytes of the buffer
+    int length;
+    // Target file. NULL when a file descriptor is used
+    FILE* file;
+    // Target file descriptor. -1 when a file is used
+    int fd;
+    // Format of the records
+    tReportFormat format;
+    // Number of fields written on the current record
+    int fields;
+    // True if a write to the target failed
+    bool error;
+} tReportWriter;
+
+// Initialize a writer to a file
+void writer_initFile(tReportWriter* writer, FILE* file, tReportFormat format);
+
+// Initialize a writer to a file descriptor
+void writer_initFd(tReportWriter* writer, int fd, tReportFormat format);
+
+// Write the buffered data to the target. Return false if some write failed
+bool writer_flush(tReportWriter* writer);
+
+// Flush the buffered data and release the writer. The target is not closed
+void writer_free(tReportWriter* writer);
+
+// Add a character
+void writer_putChar(tReportWriter* writer, char c);
+
+// Add a string. NULL strings are empty
+void writer_putStr(tReportWriter* writer, const char* str);
+
+// Add an integer
+void writer_putInt(tReportWriter* writer, int value);
+
+// Add a non negative integer with leading zeros up to the given width
+void writer_putIntPad(tReportWriter* writer, int value, int width);
+
+// Add a date with the format dd/mm/yyyy
+void writer_putDate(tReportWriter* writer, tDate date);
+
+// Add a time with the format hh:mm
+void writer_putTime(tReportWriter* writer, tTime time);
+
+// Start a record of the given type
+void writer_beginRecord(tReportWriter* writer, const char* type);
+
+// Add a text field to the current record
+void writer_fieldStr(tReportWriter* writer, const char* name, const char* value);
+
+// Add an integer field to the current record
+void writer_fieldInt(tReportWriter* writer, const char* name, int value);
+
+// Add a date field to the current record
+void writer_fieldDate(tReportWriter* writer, const char* name, tDate value);
+
+// Add a time field to the current record
+void writer_fieldTime(tReportWriter* writer, const char* name, tTime value);
+
+// End the current record
+void writer_endRecord(tReportWriter* writer);
+
+// [AUX METHOD] Add the given number of bytes
+void writer_putBytes(tReportWriter* writer, const char* bytes, int length);
+
+// [AUX METHOD] Start a field of the current record, adding its separator and name
+void writer_beginField(tReportWriter* writer, const char* name);
+
+// [AUX METHOD] Add a string escaped as the content of a JSON string
+void writer_putJsonStr(tReportWriter* writer, const char* str);
+
+#endif // __WRITER__H
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <assert.h>
 #include "csv.h"
 #include "api.h"
@@ -20,7 +21,6 @@ tApiError api_loadData(tApiData* data, const char* filename, bool reset) {
     tApiError error;
     FILE *fin;    
     char buffer[FILE_READ_BUFFER_SIZE];
-    tCSVEntry entry;
     
     // Check input data
     assert( data != NULL );
@@ -52,14 +52,12 @@ tApiError api_loadData(tApiData* data, const char* filename, bool reset) {
         // Remove new line character     
         buffer[strcspn(buffer, "\n\r")] = '\0';
         
-        csv_initEntry(&entry);
-        csv_parseEntry(&entry, buffer, NULL);
-        // Add this new entry to the api Data
-        error = api_addDataEntry(data, entry);
+        // Add this new entry to the api Data, decoding it from the line buffer
+        error = api_addDataLine(data, buffer);
         if (error != E_SUCCESS) {
+            fclose(fin);
             return error;
         }
-        csv_freeEntry(&entry);
     }
     
     fclose(fin);
@@ -87,6 +85,51 @@ tApiError api_initData(tApiData* data) {
     centerList_init(&(data->centers));
     /////////////////////////////////
     
+    // Initialize the availability cache
+    data->availability = (tAvailabilityCache*) malloc(sizeof(tAvailabilityCache));
+    if (data->availability == NULL) {
+        return E_MEMORY_ERROR;
+    }
+    availabilityCache_init(data->availability, AVAILABILITY_CACHE_SIZE);
+    
+    // Register the handlers of the known entry types
+    data->handlers = (tApiEntryTypes*) calloc(1, sizeof(tApiEntryTypes));
+    if (data->handlers == NULL) {
+        return E_MEMORY_ERROR;
+    }
+    api_registerEntryType(data, "PERSON", api_addPersonFields);
+    api_registerEntryType(data, "VACCINE_LOT", api_addVaccineLotFields);
+    
+    // Store the text fields on a shared arena
+    data->strings = (tStringArena*) malloc(sizeof(tStringArena));
+    if (data->strings == NULL) {
+        return E_MEMORY_ERROR;
+    }
+    stringArena_init(data->strings);
+    data->population.arena = data->strings;
+    data->vaccineLots.arena = data->strings;
+    data->centers.arena = data->strings;
+    
+    // Intern the postal codes
+    data->cps = (tPostalCodeTable*) malloc(sizeof(tPostalCodeTable));
+    if (data->cps == NULL) {
+        return E_MEMORY_ERROR;
+    }
+    postalCodeTable_init(data->cps, data->strings);
+    data->population.cps = data->cps;
+    data->vaccineLots.cps = data->cps;
+    data->centers.cps = data->cps;
+    
+    // Documents are not validated by default
+    data->checkDocuments = false;
+    
+    // Initialize the holds
+    data->holds = (tHoldWheel*) malloc(sizeof(tHoldWheel));
+    if (data->holds == NULL) {
+        return E_MEMORY_ERROR;
+    }
+    holdWheel_init(data->holds);
+    
     return E_SUCCESS;
     
     /////////////////////////////////
@@ -98,65 +141,16 @@ tApiError api_addVaccineLot(tApiData* data, tCSVEntry entry) {
     //////////////////////////////////
     // Ex PR1 2c
     /////////////////////////////////
-    tVaccine vaccine;
-    tVaccineLot lot;
-    tVaccine *pVaccine;
-    
-    //////////////////////////////////
-    // Ex PR2 3c
-    /////////////////////////////////
-    tHealthCenter *pCenter;
-    /////////////////////////////////
-    
     // Check input data structure
     assert(data != NULL);
     
     // Check the entry type
-    if (strcmp(csv_getType(&entry), "VACCINE_LOT") != 0) {
+    if (csv_getTypeId(&entry) != CSV_TYPE_VACCINE_LOT) {
         return E_INVALID_ENTRY_TYPE;
     }
     
-    // Check the number of fields
-    if(csv_numFields(entry) != 7) {
-        return E_INVALID_ENTRY_FORMAT;
-    }
-    
-    // Parse the entry
-    vaccineLot_parse(&vaccine, &lot, entry);
-    
-    // Check if vaccine exists
-    pVaccine = vaccineList_find(data->vaccines, vaccine.name);
-    if (pVaccine == NULL) {
-        // Add the vaccine
-        vaccineList_insert(&(data->vaccines), vaccine);
-        pVaccine = vaccineList_find(data->vaccines, vaccine.name);
-    }
-    assert(pVaccine != NULL);
-    
-    // Assign this vaccine to the lot
-    lot.vaccine = pVaccine;
-    
-    // Add the lot to the data
-    vaccineLotData_add(&(data->vaccineLots), lot);
-    
-    
-    //////////////////////////////////
-    // Ex PR2 3c
-    /////////////////////////////////
-    pCenter = centerList_find(&(data->centers), lot.cp);
-    if (pCenter == NULL) {
-        centerList_insert(&(data->centers), lot.cp);
-        pCenter = centerList_find(&(data->centers), lot.cp);
-    }
-    stockList_update(&(pCenter->stock), lot.timestamp.date, lot.vaccine, lot.doses);
-    /////////////////////////////////
-    
-    
-    // Release temporal data
-    vaccine_free(&vaccine);
-    vaccineLot_free(&lot);
-    
-    return E_SUCCESS;
+    // Add the lot from the entry fields
+    return api_addVaccineLotFields(data, entry.fields, csv_numFields(entry));
     
     /////////////////////////////////
     
@@ -194,11 +188,20 @@ int api_vaccineLotsCount(tApiData data) {
 }
 
 
+// Enable or disable the validation of the DNI and NIE check letters of new persons
+void api_setDocumentValidation(tApiData* data, bool enabled) {
+    assert(data != NULL);
+    
+    data->checkDocuments = enabled;
+}
+
 // Free all used memory
 tApiError api_freeData(tApiData* data) {
     //////////////////////////////////
     // Ex PR1 2e
     /////////////////////////////////
+    int i;
+    
     population_free(&(data->population));
     vaccineLotData_free(&(data->vaccineLots));
     vaccineList_free(&(data->vaccines));
@@ -209,6 +212,52 @@ tApiError api_freeData(tApiData* data) {
     centerList_free(&(data->centers));
     /////////////////////////////////
     
+    // Remove cached answers. They refer to the released centers
+    if (data->availability != NULL) {
+        availabilityCache_free(data->availability);
+        free(data->availability);
+        data->availability = NULL;
+    }
+    
+    // Remove the holds. They refer to the released centers
+    if (data->holds != NULL) {
+        holdWheel_free(data->holds);
+        free(data->holds);
+        data->holds = NULL;
+    }
+    
+    // Remove entry handlers
+    if (data->handlers != NULL) {
+        for (i = 0; i < data->handlers->count; i++) {
+            free(data->handlers->elems[i].name);
+        }
+        if (data->handlers->elems != NULL) {
+            free(data->handlers->elems);
+        }
+        free(data->handlers);
+        data->handlers = NULL;
+    }
+    
+    // Remove the postal codes
+    if (data->cps != NULL) {
+        postalCodeTable_free(data->cps);
+        free(data->cps);
+        data->cps = NULL;
+    }
+    data->population.cps = NULL;
+    data->vaccineLots.cps = NULL;
+    data->centers.cps = NULL;
+    
+    // Remove all the text fields at once
+    if (data->strings != NULL) {
+        stringArena_free(data->strings);
+        free(data->strings);
+        data->strings = NULL;
+    }
+    data->population.arena = NULL;
+    data->vaccineLots.arena = NULL;
+    data->centers.arena = NULL;
+    
     return E_SUCCESS;
     /////////////////////////////////
     //return E_NOT_IMPLEMENTED;
@@ -220,45 +269,192 @@ tApiError api_addDataEntry(tApiData* data, tCSVEntry entry) {
     //////////////////////////////////
     // Ex PR1 2f
     /////////////////////////////////
-    int personIdx;
-    tPerson person;
-        
+    tApiEntryHandler handler;
+    
     assert(data != NULL);
     
-    // Initialize the person object
-    person_init(&person);
-        
-    if (strcmp(csv_getType(&entry), "PERSON") == 0) {
-        // Check the number of fields
-        if(csv_numFields(entry) != 7) {
-            return E_INVALID_ENTRY_FORMAT;
-        }
-        // Parse the data
-        person_parse(&person, entry);
-        
-        // Check if this person already exists
-        if (population_find(data->population, person.document) >= 0) {
-            // Release person object
-            person_free(&person);
-            return E_DUPLICATED_PERSON;
-        }
-        
-        // Add the new person
-        population_add(&(data->population), person);
-        
-        // Release person object
-        person_free(&person);
-        
-    } else if (strcmp(csv_getType(&entry), "VACCINE_LOT") == 0) {
-        return api_addVaccineLot(data, entry);        
-    } else {
+    // Dispatch the entry to the handler of its type
+    handler = api_getEntryHandler(data, csv_getTypeId(&entry), csv_getType(&entry));
+    if (handler == NULL) {
         return E_INVALID_ENTRY_TYPE;
     }
-    return E_SUCCESS;
+    
+    return handler(data, entry.fields, csv_numFields(entry));
     /////////////////////////////////
     //return E_NOT_IMPLEMENTED;
 }
 
+// Add a new entry from a CSV line. The line is modified to split the fields
+tApiError api_addDataLine(tApiData* data, char* line) {
+    char* fields[API_MAX_FIELDS];
+    int numFields;
+    tApiEntryHandler handler;
+    
+    assert(data != NULL);
+    assert(line != NULL);
+    
+    // First field is the entry type
+    numFields = csv_splitLine(line, fields, API_MAX_FIELDS) - 1;
+    if (numFields < 0) {
+        return E_INVALID_ENTRY_TYPE;
+    }
+    
+    // Dispatch the entry to the handler of its type
+    handler = api_getEntryHandler(data, csv_findType(fields[0]), fields[0]);
+    if (handler == NULL) {
+        return E_INVALID_ENTRY_TYPE;
+    }
+    
+    return handler(data, fields + 1, numFields);
+}
+
+// Register the handler for entries of a given type on this data, replacing the previous one. Other data are not changed
+tApiError api_registerEntryType(tApiData* data, const char* type, tApiEntryHandler handler) {
+    tApiEntryTypes *pTypes;
+    int typeId;
+    int i;
+    
+    assert(data != NULL);
+    assert(type != NULL);
+    assert(data->handlers != NULL);
+    
+    pTypes = data->handlers;
+    
+    // Known types are indexed by their id
+    typeId = csv_findType(type);
+    if (typeId != CSV_UNKNOWN_TYPE) {
+        pTypes->known[typeId] = handler;
+        return E_SUCCESS;
+    }
+    
+    // Other types are found by their name
+    for (i = 0; i < pTypes->count; i++) {
+        if (strcmp(pTypes->elems[i].name, type) == 0) {
+            pTypes->elems[i].handler = handler;
+            return E_SUCCESS;
+        }
+    }
+    pTypes->elems = (tApiEntryType*) realloc(pTypes->elems, (pTypes->count + 1) * sizeof(tApiEntryType));
+    if (pTypes->elems == NULL) {
+        return E_MEMORY_ERROR;
+    }
+    pTypes->elems[pTypes->count].name = (char*) malloc((strlen(type) + 1) * sizeof(char));
+    if (pTypes->elems[pTypes->count].name == NULL) {
+        return E_MEMORY_ERROR;
+    }
+    strcpy(pTypes->elems[pTypes->count].name, type);
+    pTypes->elems[pTypes->count].handler = handler;
+    pTypes->count++;
+    
+    return E_SUCCESS;
+}
+
+// [AUX METHOD] Get the handler for entries of a type, given by its id if it is known by the CSV parser or by its name otherwise. NULL if there is no handler
+tApiEntryHandler api_getEntryHandler(tApiData* data, int typeId, const char* type) {
+    int i;
+    
+    assert(data != NULL);
+    
+    if (data->handlers == NULL) {
+        return NULL;
+    }
+    if (typeId != CSV_UNKNOWN_TYPE) {
+        return data->handlers->known[typeId];
+    }
+    if (type == NULL) {
+        return NULL;
+    }
+    
+    for (i = 0; i < data->handlers->count; i++) {
+        if (strcmp(data->handlers->elems[i].name, type) == 0) {
+            return data->handlers->elems[i].handler;
+        }
+    }
+    
+    return NULL;
+}
+
+// [AUX METHOD] Add a new person from the fields of an entry
+tApiError api_addPersonFields(tApiData* data, char** fields, int numFields) {
+    tPerson person;
+    tPersonContact contact;
+    
+    assert(data != NULL);
+    
+    // Check the number of fields
+    if (numFields != 7) {
+        return E_INVALID_ENTRY_FORMAT;
+    }
+    
+    // Parse the data without copying it
+    if (!person_parseView(&person, &contact, fields)) {
+        return E_INVALID_ENTRY_FORMAT;
+    }
+    
+    // Check the letter of DNI and NIE documents
+    if (data->checkDocuments && person.key != DOCUMENT_KEY_NONE && !document_isValid(person.document)) {
+        return E_INVALID_DOCUMENT;
+    }
+    
+    // Check if this person already exists
+    if (population_find(data->population, person.document) >= 0) {
+        return E_DUPLICATED_PERSON;
+    }
+    
+    // Add the new person. This is the only copy of its data
+    population_add(&(data->population), person, contact);
+    
+    return E_SUCCESS;
+}
+
+// [AUX METHOD] Add a new vaccines lot from the fields of an entry
+tApiError api_addVaccineLotFields(tApiData* data, char** fields, int numFields) {
+    tVaccine vaccine;
+    tVaccineLot lot;
+    tVaccine *pVaccine;
+    tHealthCenter *pCenter;
+    
+    assert(data != NULL);
+    
+    // Check the number of fields
+    if (numFields != 7) {
+        return E_INVALID_ENTRY_FORMAT;
+    }
+    
+    // Parse the data without copying it
+    if (!vaccineLot_parseView(&vaccine, &lot, fields)) {
+        return E_INVALID_ENTRY_FORMAT;
+    }
+    
+    // Check if vaccine exists
+    pVaccine = vaccineList_find(data->vaccines, vaccine.name);
+    if (pVaccine == NULL) {
+        // Add the vaccine
+        vaccineList_insert(&(data->vaccines), vaccine);
+        pVaccine = vaccineList_find(data->vaccines, vaccine.name);
+    }
+    assert(pVaccine != NULL);
+    
+    // Assign this vaccine to the lot
+    lot.vaccine = pVaccine;
+    
+    // Add the lot to the data
+    vaccineLotData_add(&(data->vaccineLots), lot);
+    
+    // Update the stock of the center
+    pCenter = centerList_find(&(data->centers), lot.cp);
+    if (pCenter == NULL) {
+        centerList_insert(&(data->centers), lot.cp);
+        pCenter = centerList_find(&(data->centers), lot.cp);
+    }
+    stockList_adjust(&(pCenter->stock), lot.timestamp.date, lot.vaccine, lot.doses);
+    
+    // Use the new doses for the persons waiting on this center
+    api_backfillWaitlist(data, pCenter, lot.timestamp);
+    
+    return E_SUCCESS;
+}
+
 // Get vaccine data
 tApiError api_getVaccine(tApiData data, const char *name, tCSVEntry *entry) {
     //////////////////////////////////
@@ -377,6 +573,41 @@ tApiError api_getVaccineLots(tApiData data, tCSVData *lots) {
     //return E_NOT_IMPLEMENTED; 
 }
 
+// Call the visitor for each registered vaccine. Return the number of visited vaccines
+int api_visitVaccines(tApiData data, tVaccineVisitor visitor, void* context) {
+    assert(visitor != NULL);
+    
+    return vaccineList_visit(data.vaccines, visitor, context);
+}
+
+// Call the visitor for each vaccine lot. Return the number of visited lots
+int api_visitVaccineLots(tApiData data, tVaccineLotVisitor visitor, void* context) {
+    assert(visitor != NULL);
+    
+    return vaccineLotData_visit(data.vaccineLots, visitor, context);
+}
+
+// Open a cursor over the registered vaccines
+void api_openVaccineCursor(tApiData* data, tVaccineCursor* cursor) {
+    assert(data != NULL);
+    
+    vaccineCursor_open(cursor, &(data->vaccines));
+}
+
+// Open a cursor over the vaccine lots
+void api_openLotCursor(tApiData* data, tLotCursor* cursor) {
+    assert(data != NULL);
+    
+    lotCursor_open(cursor, &(data->vaccineLots));
+}
+
+// Open a cursor over the population
+void api_openPopulationCursor(tApiData* data, tPopulationCursor* cursor) {
+    assert(data != NULL);
+    
+    populationCursor_open(cursor, &(data->population));
+}
+
 // Get the number of health centers registered on the application
 int api_centersCount(tApiData data) {
     //////////////////////////////////
@@ -390,30 +621,239 @@ int api_centersCount(tApiData data) {
 
 // Print center stock
 void api_printCenterStock(tApiData data, const char* cp) {
+    tReportWriter writer;
+    
+    writer_initFile(&writer, stdout, REPORT_CSV);
+    api_writeCenterStock(data, cp, &writer);
+    writer_free(&writer);
+}
+
+// Write center stock with the format of api_printCenterStock
+void api_writeCenterStock(tApiData data, const char* cp, tReportWriter* writer) {
     tHealthCenter *pCenter;
     
     // Check input data    
     assert(cp != NULL);
+    assert(writer != NULL);
     
     // Search the health center
     pCenter = centerList_find(&(data.centers), cp);
     if (pCenter != NULL) {
-        printf("==============================\n");
-        printf("STOCK FOR CENTER %s\n", cp);
-        printf("==============================\n");
-        stockList_print(pCenter->stock);
-        printf("==============================\n\n");
+        writer_putStr(writer, "==============================\nSTOCK FOR CENTER ");
+        writer_putStr(writer, cp);
+        writer_putStr(writer, "\n==============================\n");
+        stockList_sync(&(pCenter->stock));
+        stockList_write(pCenter->stock, writer);
+        writer_putStr(writer, "==============================\n\n");
     }    
 }
 
-// Add a new vaccination appointment
+// Write a record for each vaccine lot, person and vaccination appointment, with the format of the writer. Return the number of records
+int api_dumpData(tApiData data, tReportWriter* writer) {
+    tVaccineLot *pLot = NULL;
+    tHealthCenterNode *pNode = NULL;
+    tDoseSeries *pSeries = NULL;
+    tDateTime timestamp;
+    int count = 0;
+    int dose;
+    int i;
+    
+    assert(writer != NULL);
+    
+    // Lots and persons use the fields of the input entries, so CSV dumps can be loaded again
+    for (i = 0; i < data.vaccineLots.count; i++) {
+        pLot = &(data.vaccineLots.elems[i]);
+        writer_beginRecord(writer, "VACCINE_LOT");
+        writer_fieldDate(writer, "date", pLot->timestamp.date);
+        writer_fieldTime(writer, "time", pLot->timestamp.time);
+        writer_fieldStr(writer, "cp", pLot->cp);
+        writer_fieldStr(writer, "vaccine", pLot->vaccine->name);
+        writer_fieldInt(writer, "required", pLot->vaccine->required);
+        writer_fieldInt(writer, "days", pLot->vaccine->days);
+        writer_fieldInt(writer, "doses", pLot->doses);
+        writer_endRecord(writer);
+        count++;
+    }
+    for (i = 0; i < data.population.count; i++) {
+        writer_beginRecord(writer, "PERSON");
+        writer_fieldStr(writer, "document", data.population.elems[i].document);
+        writer_fieldStr(writer, "name", data.population.contacts[i].name);
+        writer_fieldStr(writer, "surname", data.population.contacts[i].surname);
+        writer_fieldStr(writer, "email", data.population.contacts[i].email);
+        writer_fieldStr(writer, "address", data.population.contacts[i].address);
+        writer_fieldStr(writer, "cp", data.population.elems[i].cp);
+        writer_fieldDate(writer, "birthday", data.population.elems[i].birthday);
+        writer_endRecord(writer);
+        count++;
+    }
+    
+    // One record for each dose
+    for (pNode = data.centers.first; pNode != NULL; pNode = pNode->next) {
+        for (i = 0; i < pNode->elem.series.count; i++) {
+            pSeries = &(pNode->elem.series.elems[i]);
+            for (dose = 0; dose < pSeries->doses; dose++) {
+                timestamp = doseSeries_getDose(*pSeries, dose);
+                writer_beginRecord(writer, "APPOINTMENT");
+                writer_fieldDate(writer, "date", timestamp.date);
+                writer_fieldTime(writer, "time", timestamp.time);
+                writer_fieldStr(writer, "cp", pNode->elem.cp);
+                writer_fieldStr(writer, "vaccine", pSeries->vaccine->name);
+                writer_fieldStr(writer, "document", data.population.elems[pSeries->person].document);
+                writer_endRecord(writer);
+                count++;
+            }
+        }
+    }
+    
+    return count;
+}
+
+// Export the vaccine lots to a column file, with their timestamps as packed keys. Return E_FILE_NOT_FOUND if it cannot be written
+tApiError api_exportLots(tApiData data, const char* filename) {
+    tColumnFile file;
+    char** vaccines;
+    int i;
+    
+    assert(filename != NULL);
+    assert(data.cps != NULL);
+    
+    if (!columnFile_open(&file, filename, data.vaccineLots.count, 6)) {
+        return E_FILE_NOT_FOUND;
+    }
+    
+    // Lots are mostly added in time order, so the differences of their packed timestamps are small
+    columnFile_beginColumn(&file, "timestamp", COLUMN_DELTA);
+    for (i = 0; i < data.vaccineLots.count; i++) {
+        columnFile_putValue(&file, (int32_t) dateTime_toKey(data.vaccineLots.elems[i].timestamp));
+    }
+    columnFile_endColumn(&file);
+    
+    // The codes of the cps are their identifiers on the postal code table
+    columnFile_beginDictionary(&file, "cp", data.cps->codes, postalCodeTable_len(data.cps));
+    for (i = 0; i < data.vaccineLots.count; i++) {
+        assert(data.vaccineLots.elems[i].cpId != POSTAL_CODE_UNKNOWN);
+        columnFile_putValue(&file, data.vaccineLots.elems[i].cpId);
+    }
+    columnFile_endColumn(&file);
+    
+    vaccines = api_getVaccineNames(data);
+    columnFile_beginDictionary(&file, "vaccine", vaccines, data.vaccines.count);
+    free(vaccines);
+    for (i = 0; i < data.vaccineLots.count; i++) {
+        columnFile_putValue(&file, api_getVaccineCode(data, data.vaccineLots.elems[i].vaccine));
+    }
+    columnFile_endColumn(&file);
+    
+    columnFile_beginColumn(&file, "required", COLUMN_PLAIN);
+    for (i = 0; i < data.vaccineLots.count; i++) {
+        columnFile_putValue(&file, data.vaccineLots.elems[i].vaccine->required);
+    }
+    columnFile_endColumn(&file);
+    
+    columnFile_beginColumn(&file, "days", COLUMN_PLAIN);
+    for (i = 0; i < data.vaccineLots.count; i++) {
+        columnFile_putValue(&file, data.vaccineLots.elems[i].vaccine->days);
+    }
+    columnFile_endColumn(&file);
+    
+    columnFile_beginColumn(&file, "doses", COLUMN_PLAIN);
+    for (i = 0; i < data.vaccineLots.count; i++) {
+        columnFile_putValue(&file, data.vaccineLots.elems[i].doses);
+    }
+    columnFile_endColumn(&file);
+    
+    if (!columnFile_close(&file)) {
+        return E_FILE_NOT_FOUND;
+    }
+    
+    return E_SUCCESS;
+}
+
+// Export the vaccination appointments of all the health centers to a column file, one row for each dose, with their timestamps as packed keys. Return E_FILE_NOT_FOUND if it cannot be written
+tApiError api_exportAppointments(tApiData data, const char* filename) {
+    tColumnFile file;
+    tHealthCenterNode *pNode = NULL;
+    tDoseSeries *pSeries = NULL;
+    char** entries;
+    int rows;
+    int column;
+    int dose;
+    int i;
+    
+    assert(filename != NULL);
+    assert(data.cps != NULL);
+    
+    rows = 0;
+    for (pNode = data.centers.first; pNode != NULL; pNode = pNode->next) {
+        for (i = 0; i < pNode->elem.series.count; i++) {
+            rows += pNode->elem.series.elems[i].doses;
+        }
+    }
+    
+    if (!columnFile_open(&file, filename, rows, 5)) {
+        return E_FILE_NOT_FOUND;
+    }
+    
+    // Each column visits all the doses in the same order
+    for (column = 0; column < 5; column++) {
+        if (column == 0) {
+            columnFile_beginColumn(&file, "timestamp", COLUMN_DELTA);
+        } else if (column == 1) {
+            columnFile_beginDictionary(&file, "cp", data.cps->codes, postalCodeTable_len(data.cps));
+        } else if (column == 2) {
+            entries = api_getVaccineNames(data);
+            columnFile_beginDictionary(&file, "vaccine", entries, data.vaccines.count);
+            free(entries);
+        } else if (column == 3) {
+            // The codes of the persons are their positions on the population
+            entries = (char**) malloc((data.population.count > 0 ? data.population.count : 1) * sizeof(char*));
+            assert(entries != NULL);
+            for (i = 0; i < data.population.count; i++) {
+                entries[i] = data.population.elems[i].document;
+            }
+            columnFile_beginDictionary(&file, "person", entries, data.population.count);
+            free(entries);
+        } else {
+            columnFile_beginColumn(&file, "dose", COLUMN_PLAIN);
+        }
+        
+        for (pNode = data.centers.first; pNode != NULL; pNode = pNode->next) {
+            for (i = 0; i < pNode->elem.series.count; i++) {
+                pSeries = &(pNode->elem.series.elems[i]);
+                for (dose = 0; dose < pSeries->doses; dose++) {
+                    if (column == 0) {
+                        columnFile_putValue(&file, (int32_t) dateTime_toKey(doseSeries_getDose(*pSeries, dose)));
+                    } else if (column == 1) {
+                        assert(pNode->elem.cpId != POSTAL_CODE_UNKNOWN);
+                        columnFile_putValue(&file, pNode->elem.cpId);
+                    } else if (column == 2) {
+                        columnFile_putValue(&file, api_getVaccineCode(data, pSeries->vaccine));
+                    } else if (column == 3) {
+                        columnFile_putValue(&file, pSeries->person);
+                    } else {
+                        columnFile_putValue(&file, dose);
+                    }
+                }
+            }
+        }
+        columnFile_endColumn(&file);
+    }
+    
+    if (!columnFile_close(&file)) {
+        return E_FILE_NOT_FOUND;
+    }
+    
+    return E_SUCCESS;
+}
+
+// Add a new vaccination appointment, taking its doses from the center stock
 tApiError api_addAppointment(tApiData* data, const char* cp, const char* document, const char* vaccine, tDateTime timestamp) {
     //////////////////////////////////
     // Ex PR3 2c
     /////////////////////////////////
     int person_idx = -1;
-    int count;    
-    tPerson *pPerson = NULL;    
+    int series_idx;
+    tDoseSeries series;
     tVaccine *pVaccine = NULL;
     tHealthCenter *pCenter;
         
@@ -428,7 +868,11 @@ tApiError api_addAppointment(tApiData* data, const char* cp, const char* documen
     if (person_idx < 0) {
         return E_PERSON_NOT_FOUND;
     }
-    pPerson = &(data->population.elems[person_idx]);
+    
+    // A person can only be booked in one center
+    if (population_isBooked(&(data->population), person_idx)) {
+        return E_DUPLICATED_PERSON;
+    }
     
     // Search vaccine
     pVaccine = vaccineList_find(data->vaccines, vaccine);    
@@ -442,11 +886,14 @@ tApiError api_addAppointment(tApiData* data, const char* cp, const char* documen
         return E_HEALTH_CENTER_NOT_FOUND;
     }
     
-    // Add the new appointment
-    for (count = 0; count < pVaccine->required; count++) {
-        appointmentData_insert(&(pCenter->appointments), timestamp, pVaccine, pPerson);
-        dateTime_addDay(&timestamp, pVaccine->days);
-    }    
+    // Add the new appointment, with all the doses of the vaccine
+    doseSeries_init(&series, person_idx, pVaccine, timestamp);
+    series_idx = doseSeriesData_add(&(pCenter->series), series);
+    population_setBooking(&(data->population), person_idx, pCenter->cpId, series_idx, pVaccine->name, pVaccine->required);
+    
+    // Take the doses from the stock, so a cancellation can return them
+    api_updateAppointmentStock(pCenter, &(pCenter->series.elems[series_idx]), -1);
+    api_updateAppointmentSlots(pCenter, &(pCenter->series.elems[series_idx]), 1);
     
     return E_SUCCESS;
     /////////////////////////////////
@@ -459,11 +906,12 @@ tApiError api_getPersonAppointments(tApiData data, const char* document, tCSVDat
     // Ex PR3 2d
     /////////////////////////////////
     int person_idx = -1;    
-    int appointment_idx;
+    int dose;
     char buffer[512];
-    tPerson *pPerson = NULL;
-    tHealthCenterNode *pCenter = NULL;     
-    tAppointment *pAppointment = NULL;
+    const tPersonBooking *pBooking = NULL;
+    tHealthCenter *pCenter = NULL;     
+    tDoseSeries *pSeries = NULL;
+    tDateTime timestamp;
     
     // Check input data    
     assert(document != NULL);
@@ -477,38 +925,30 @@ tApiError api_getPersonAppointments(tApiData data, const char* document, tCSVDat
     if (person_idx < 0) {
         return E_PERSON_NOT_FOUND;
     }
-    pPerson = &(data.population.elems[person_idx]);
-    
-    // Search vaccination appointments in each center
-    pCenter = data.centers.first;
-    while(pCenter != NULL) {     
-        // Add all appointments for this center
-        appointment_idx = 0;
-        while (appointment_idx >= 0) {
-            // Find next appointment
-            appointment_idx = appointmentData_find(pCenter->elem.appointments, pPerson, appointment_idx);
-            if (appointment_idx >= 0) {
-                // Get a pointer to the appointment for convenience
-                pAppointment = &(pCenter->elem.appointments.elems[appointment_idx]);
-                
-                // Create a string with required format
-                sprintf(buffer, "%02d/%02d/%04d;%02d:%02d;%s;%s", 
-                    pAppointment->timestamp.date.day, pAppointment->timestamp.date.month, pAppointment->timestamp.date.year,
-                    pAppointment->timestamp.time.hour, pAppointment->timestamp.time.minutes,
-                    pCenter->elem.cp, 
-                    pAppointment->vaccine->name
-                );   
-                
-                // Add this string to the final report                
-                csv_addStrEntry(appointments, buffer, "APPOINTMENT");   
-
-                // Increment current index to find next appointments
-                appointment_idx++;
-            }
-        }
+    
+    // The booking gives the center and the dose series of the person
+    pBooking = population_getBooking(&(data.population), person_idx);
+    if (pBooking->doses == 0) {
+        return E_SUCCESS;
+    }
+    pCenter = centerList_findById(&(data.centers), pBooking->centerId);
+    assert(pCenter != NULL);
+    pSeries = &(pCenter->series.elems[pBooking->series]);
+    
+    // Add one appointment for each dose
+    for (dose = 0; dose < pSeries->doses; dose++) {
+        timestamp = doseSeries_getDose(*pSeries, dose);
+        
+        // Create a string with required format
+        sprintf(buffer, "%02d/%02d/%04d;%02d:%02d;%s;%s", 
+            timestamp.date.day, timestamp.date.month, timestamp.date.year,
+            timestamp.time.hour, timestamp.time.minutes,
+            pCenter->cp, 
+            pSeries->vaccine->name
+        );   
         
-        // Move to next center
-        pCenter = pCenter->next;
+        // Add this string to the final report                
+        csv_addStrEntry(appointments, buffer, "APPOINTMENT");   
     }
     
     return E_SUCCESS;
@@ -516,6 +956,77 @@ tApiError api_getPersonAppointments(tApiData data, const char* document, tCSVDat
     // return E_NOT_IMPLEMENTED; 
 }
 
+// Call the visitor for each vaccination appointment of a person
+tApiError api_visitPersonAppointments(tApiData data, const char* document, tAppointmentVisitor visitor, void* context) {
+    int person_idx = -1;
+    const tPersonBooking *pBooking = NULL;
+    tHealthCenter *pCenter = NULL;
+    
+    assert(document != NULL);
+    assert(visitor != NULL);
+    
+    person_idx = population_find(data.population, document);
+    if (person_idx < 0) {
+        return E_PERSON_NOT_FOUND;
+    }
+    
+    // The booking gives the center and the dose series of the person
+    pBooking = population_getBooking(&(data.population), person_idx);
+    if (pBooking->doses == 0) {
+        return E_SUCCESS;
+    }
+    pCenter = centerList_findById(&(data.centers), pBooking->centerId);
+    assert(pCenter != NULL);
+    doseSeries_visit(&(pCenter->series.elems[pBooking->series]), data.population.elems, pCenter->cp, visitor, context);
+    
+    return E_SUCCESS;
+}
+
+// Open a cursor over the vaccination appointments of a person. On errors the cursor is empty
+tApiError api_openPersonAppointmentCursor(tApiData* data, const char* document, tAppointmentCursor* cursor) {
+    int person_idx = -1;
+    const tPersonBooking *pBooking = NULL;
+    tHealthCenter *pCenter = NULL;
+    
+    assert(data != NULL);
+    assert(document != NULL);
+    
+    appointmentCursor_open(cursor, NULL, NULL, 0, 0);
+    
+    person_idx = population_find(data->population, document);
+    if (person_idx < 0) {
+        return E_PERSON_NOT_FOUND;
+    }
+    
+    // The cursor only covers the dose series of the person
+    pBooking = population_getBooking(&(data->population), person_idx);
+    if (pBooking->doses > 0) {
+        pCenter = centerList_findById(&(data->centers), pBooking->centerId);
+        assert(pCenter != NULL);
+        appointmentCursor_open(cursor, &(pCenter->series), &(data->population), pBooking->series, pBooking->series + 1);
+    }
+    
+    return E_SUCCESS;
+}
+
+// Open a cursor over the vaccination appointments of a health center. On errors the cursor is empty
+tApiError api_openCenterAppointmentCursor(tApiData* data, const char* cp, tAppointmentCursor* cursor) {
+    tHealthCenter *pCenter = NULL;
+    
+    assert(data != NULL);
+    assert(cp != NULL);
+    
+    appointmentCursor_open(cursor, NULL, NULL, 0, 0);
+    
+    pCenter = centerList_find(&(data->centers), cp);
+    if (pCenter == NULL) {
+        return E_HEALTH_CENTER_NOT_FOUND;
+    }
+    appointmentCursor_open(cursor, &(pCenter->series), &(data->population), 0, pCenter->series.count);
+    
+    return E_SUCCESS;
+}
+
 // Check availability of a vaccine in a given health center
 bool api_checkAvailability(tApiData data, const char* cp, const char* vaccine, tDate date) {
     //////////////////////////////////
@@ -524,6 +1035,7 @@ bool api_checkAvailability(tApiData data, const char* cp, const char* vaccine, t
     bool available = true;
     tVaccine *pVaccine = NULL;
     tHealthCenter *pCenter = NULL;    
+    tDate firstDay;
     int count;
     
     // Check input data    
@@ -541,6 +1053,12 @@ bool api_checkAvailability(tApiData data, const char* cp, const char* vaccine, t
     if (pCenter == NULL) {
         return false;
     }
+    
+    // Use the previous answer if the stock did not change since it was computed
+    if (data.availability != NULL && availabilityCache_find(data.availability, pCenter, pVaccine, date, &available)) {
+        return available;
+    }
+    firstDay = date;
         
     // Check availability for all doses
     available = true;
@@ -552,22 +1070,363 @@ bool api_checkAvailability(tApiData data, const char* cp, const char* vaccine, t
         date_addDay(&date, pVaccine->days);
     }
     
+    // Store the answer for next checks
+    if (data.availability != NULL) {
+        availabilityCache_store(data.availability, pCenter, pVaccine, firstDay, available);
+    }
+    
     return available;
     /////////////////////////////////
     // return false;
 }
 
+// Get the first date not before the given one where a center has the doses of a vaccine for the given number of persons
+tApiError api_findEarliestAvailability(tApiData data, const char* cp, const char* vaccine, tDate date, int persons, tDate* first) {
+    tVaccine *pVaccine = NULL;
+    tHealthCenter *pCenter = NULL;
+    
+    assert(cp != NULL);
+    assert(vaccine != NULL);
+    assert(first != NULL);
+    
+    pVaccine = vaccineList_find(data.vaccines, vaccine);
+    if (pVaccine == NULL) {
+        return E_VACCINE_NOT_FOUND;
+    }
+    
+    pCenter = centerList_find(&(data.centers), cp);
+    if (pCenter == NULL) {
+        return E_HEALTH_CENTER_NOT_FOUND;
+    }
+    
+    if (!stockList_findFirstSeries(&(pCenter->stock), date, pVaccine, persons, first)) {
+        return E_NO_VACCINES;
+    }
+    
+    return E_SUCCESS;
+}
+
+// Get the first date not before the given one where a center has at least the given doses of a vaccine
+tApiError api_findEarliestStock(tApiData data, const char* cp, const char* vaccine, tDate date, int doses, tDate* first) {
+    tVaccine *pVaccine = NULL;
+    tHealthCenter *pCenter = NULL;
+    
+    assert(cp != NULL);
+    assert(vaccine != NULL);
+    assert(first != NULL);
+    
+    pVaccine = vaccineList_find(data.vaccines, vaccine);
+    if (pVaccine == NULL) {
+        return E_VACCINE_NOT_FOUND;
+    }
+    
+    pCenter = centerList_find(&(data.centers), cp);
+    if (pCenter == NULL) {
+        return E_HEALTH_CENTER_NOT_FOUND;
+    }
+    
+    if (!stockList_findFirst(&(pCenter->stock), date, pVaccine, doses, first)) {
+        return E_NO_VACCINES;
+    }
+    
+    return E_SUCCESS;
+}
+
+// Store on result the positions of the requests with availability for all their doses. Result must be initialized and is replaced. Return the number of available requests
+int api_checkAvailabilityBatch(tApiData data, const tAvailabilityRequest* requests, int count, tBitmap* result) {
+    tAvailabilityBatchItem *items = NULL;
+    tVaccine *pVaccine = NULL;
+    tHealthCenter *pCenter = NULL;
+    tStockTimeline *pTimeline = NULL;
+    int *doses = NULL;
+    int dosesCapacity = 0;
+    int firstDay;
+    int span;
+    int day;
+    int numDoses;
+    int available;
+    int dose;
+    bool ok;
+    int i;
+    int j;
+    int k;
+    
+    assert(requests != NULL || count == 0);
+    assert(result != NULL);
+    
+    bitmap_free(result);
+    if (count <= 0) {
+        return 0;
+    }
+    
+    // Sort the requests, so each center and vaccine is searched once
+    items = (tAvailabilityBatchItem*) malloc(count * sizeof(tAvailabilityBatchItem));
+    assert(items != NULL);
+    for (i = 0; i < count; i++) {
+        assert(requests[i].cp != NULL);
+        assert(requests[i].vaccine != NULL);
+        items[i].request = &(requests[i]);
+        items[i].day = date_toDays(requests[i].date);
+        items[i].pos = i;
+    }
+    qsort(items, count, sizeof(tAvailabilityBatchItem), api_batchItemCmp);
+    
+    available = 0;
+    for (i = 0; i < count; i = j) {
+        // Search the end of the group
+        j = i + 1;
+        while (j < count && strcmp(items[j].request->cp, items[i].request->cp) == 0 && 
+               strcmp(items[j].request->vaccine, items[i].request->vaccine) == 0) {
+            j++;
+        }
+        
+        // Unknown centers and vaccines have no availability
+        pTimeline = NULL;
+        pVaccine = vaccineList_find(data.vaccines, items[i].request->vaccine);
+        pCenter = centerList_find(&(data.centers), items[i].request->cp);
+        if (pVaccine != NULL && pCenter != NULL) {
+            pTimeline = stockList_getTimeline(&(pCenter->stock), pVaccine, false);
+        }
+        if (pTimeline == NULL) {
+            continue;
+        }
+        
+        // Read the doses of all the days of the group at once. Days are sorted, and the last one needs all its doses
+        firstDay = items[i].day;
+        span = items[j - 1].day - firstDay + (pVaccine->required - 1) * pVaccine->days + 1;
+        if (span <= API_BATCH_MAX_DAYS) {
+            if (span > dosesCapacity) {
+                doses = (int*) realloc(doses, span * sizeof(int));
+                assert(doses != NULL);
+                dosesCapacity = span;
+            }
+            timeline_getRange(pTimeline, firstDay, span, doses);
+        }
+        
+        // Check availability of doses, taking into account previous required doses
+        for (k = i; k < j; k++) {
+            ok = true;
+            for (dose = 0; dose < pVaccine->required && ok; dose++) {
+                day = items[k].day + dose * pVaccine->days;
+                if (span <= API_BATCH_MAX_DAYS) {
+                    numDoses = doses[day - firstDay];
+                } else {
+                    numDoses = timeline_getDoses(pTimeline, day);
+                }
+                ok = numDoses > dose;
+            }
+            if (ok) {
+                bitmap_add(result, (uint32_t) items[k].pos);
+                available++;
+            }
+        }
+    }
+    
+    if (doses != NULL) {
+        free(doses);
+    }
+    free(items);
+    
+    return available;
+}
+
+// [AUX METHOD] Compare two checks of a batch by health center, vaccine and day
+int api_batchItemCmp(const void* a, const void* b) {
+    const tAvailabilityBatchItem *pA = (const tAvailabilityBatchItem*) a;
+    const tAvailabilityBatchItem *pB = (const tAvailabilityBatchItem*) b;
+    int cmp;
+    
+    cmp = strcmp(pA->request->cp, pB->request->cp);
+    if (cmp == 0) {
+        cmp = strcmp(pA->request->vaccine, pB->request->vaccine);
+    }
+    if (cmp == 0 && pA->day != pB->day) {
+        cmp = pA->day < pB->day ? -1 : 1;
+    }
+    
+    return cmp;
+}
+
+// Get the number of availability answers served from the cache and computed from the stock
+void api_getAvailabilityCacheStats(tApiData data, int* hits, int* misses) {
+    assert(hits != NULL);
+    assert(misses != NULL);
+    
+    *hits = 0;
+    *misses = 0;
+    if (data.availability != NULL) {
+        *hits = data.availability->hits;
+        *misses = data.availability->misses;
+    }
+}
+
+// Get the number of bytes used by the stored text fields
+size_t api_getStringsSize(tApiData data) {
+    if (data.strings == NULL) {
+        return 0;
+    }
+    return stringArena_size(data.strings);
+}
+
+// Set the appointments per slot of a center and its opening hours. A capacity of 0 removes the limit
+tApiError api_setCenterCapacity(tApiData* data, const char* cp, int capacity, tTime open, tTime close) {
+    tHealthCenter *pCenter;
+    
+    assert(data != NULL);
+    assert(cp != NULL);
+    
+    pCenter = centerList_find(&(data->centers), cp);
+    if (pCenter == NULL) {
+        return E_HEALTH_CENTER_NOT_FOUND;
+    }
+    slotCalendar_setCapacity(&(pCenter->slots), capacity, open, close);
+    
+    return E_SUCCESS;
+}
+
+// Get the number of persons waiting for vaccines on a center
+int api_waitlistCount(tApiData data, const char* cp) {
+    tHealthCenter *pCenter;
+    
+    assert(cp != NULL);
+    
+    pCenter = centerList_find(&(data.centers), cp);
+    if (pCenter == NULL) {
+        return 0;
+    }
+    
+    return waitlist_len(pCenter->waitlist);
+}
+
+// Get the number of distinct postal codes
+int api_postalCodesCount(tApiData data) {
+    if (data.cps == NULL) {
+        return 0;
+    }
+    return postalCodeTable_len(data.cps);
+}
+
+// Call the visitor for each person living on the given cp. Return the number of visited persons
+int api_visitResidents(tApiData data, const char* cp, tPersonVisitor visitor, void* context) {
+    assert(cp != NULL);
+    assert(visitor != NULL);
+    
+    if (data.cps == NULL) {
+        return 0;
+    }
+    
+    return population_visitCp(&(data.population), postalCodeTable_find(data.cps, cp), visitor, context);
+}
+
+// Call the visitor for each person living on a cp starting with the given prefix. Return the number of visited persons
+int api_visitRegionResidents(tApiData data, const char* prefix, tPersonVisitor visitor, void* context) {
+    int cpId;
+    int visited;
+    size_t length;
+    
+    assert(prefix != NULL);
+    assert(visitor != NULL);
+    
+    if (data.cps == NULL) {
+        return 0;
+    }
+    
+    // Only the distinct cps are compared as strings
+    length = strlen(prefix);
+    visited = 0;
+    for (cpId = 0; cpId < postalCodeTable_len(data.cps); cpId++) {
+        if (strncmp(postalCodeTable_get(data.cps, cpId), prefix, length) == 0) {
+            visited += population_visitCp(&(data.population), cpId, visitor, context);
+        }
+    }
+    
+    return visited;
+}
+
+// Store on result the persons living on a cp starting with the given prefix. Result must be initialized and is replaced
+void api_getResidentsSet(tApiData* data, const char* prefix, tBitmap* result) {
+    const tBitmap *pSet;
+    size_t length;
+    int cpId;
+    
+    assert(data != NULL);
+    assert(prefix != NULL);
+    assert(result != NULL);
+    
+    bitmap_free(result);
+    if (data->cps == NULL) {
+        return;
+    }
+    
+    // Join the sets of the matching cps
+    length = strlen(prefix);
+    for (cpId = 0; cpId < postalCodeTable_len(data->cps); cpId++) {
+        pSet = population_getCpSet(&(data->population), cpId);
+        if (pSet != NULL && strncmp(postalCodeTable_get(data->cps, cpId), prefix, length) == 0) {
+            bitmap_or(result, pSet, result);
+        }
+    }
+}
+
+// Store on result the persons born before the cutoff. Result must be initialized and is replaced
+void api_getBornBeforeSet(tApiData* data, tDate cutoff, tBitmap* result) {
+    assert(data != NULL);
+    assert(result != NULL);
+    
+    population_getBornBefore(&(data->population), cutoff, result);
+}
+
+// Store on result the persons with appointments for a vaccine, or any vaccine if it is NULL. Result must be initialized and is replaced
+void api_getScheduledSet(tApiData* data, const char* vaccine, tBitmap* result) {
+    const tBitmap *pSet;
+    
+    assert(data != NULL);
+    assert(result != NULL);
+    
+    pSet = population_getScheduledSet(&(data->population), vaccine);
+    if (pSet == NULL) {
+        bitmap_free(result);
+    } else {
+        bitmap_cpy(result, pSet);
+    }
+}
+
+// Call the visitor for each person of a set. Return the number of visited persons
+int api_visitPersonSet(tApiData* data, const tBitmap* persons, tPersonVisitor visitor, void* context) {
+    assert(data != NULL);
+    
+    return population_visitSet(&(data->population), persons, visitor, context);
+}
+
+// Call the visitor for each person without appointments born before the cutoff, from the oldest one. If cp is not NULL only its residents are visited. Return the number of visited persons
+int api_getEligibleCohort(tApiData* data, tDate birthdayCutoff, const char* cp, tPersonVisitor visitor, void* context) {
+    int cpId;
+    
+    assert(data != NULL);
+    assert(visitor != NULL);
+    
+    // Filter by the interned cp
+    cpId = POSTAL_CODE_UNKNOWN;
+    if (cp != NULL) {
+        if (data->cps == NULL) {
+            return 0;
+        }
+        cpId = postalCodeTable_find(data->cps, cp);
+        if (cpId == POSTAL_CODE_UNKNOWN) {
+            return 0;
+        }
+    }
+    
+    return population_visitEligible(&(data->population), birthdayCutoff, cpId, visitor, context);
+}
+
 // Find available vaccination appointment
 tApiError api_findAppointmentAvailability(tApiData* data, const char* cp, const char* document, tDateTime timestamp) {
     //////////////////////////////////
     // Ex PR3 3b
     /////////////////////////////////
-    tPerson *pPerson = NULL;   
     tHealthCenter *pCenter = NULL;
-    tVaccineNode *pVaccineNode = NULL;
     int person_idx;
-    int day;
-    int appointment_created = false;
     
     // Check input data    
     assert(data != NULL);
@@ -579,7 +1438,6 @@ tApiError api_findAppointmentAvailability(tApiData* data, const char* cp, const
     if (person_idx < 0) {
         return E_PERSON_NOT_FOUND;
     }
-    pPerson = &(data->population.elems[person_idx]);
     
     // Search the health center
     pCenter = centerList_find(&(data->centers), cp);
@@ -587,86 +1445,489 @@ tApiError api_findAppointmentAvailability(tApiData* data, const char* cp, const
         return E_HEALTH_CENTER_NOT_FOUND;
     }
     
-    // Check if this person already have appointments
-    if(appointmentData_find(pCenter->appointments, pPerson, 0) >= 0) {
+    // Check if this person already have appointments in any center
+    if(population_isBooked(&(data->population), person_idx)) {
         return E_DUPLICATED_PERSON;
     }
     
-    // Week 1: Assign only if availability is complete
-    appointment_created = false;
-    for(day=0; day < 7 && !appointment_created; day++) {
-        // We will traverse all vaccines (it is possible to limit to the available vaccines in daily stock)
-        pVaccineNode = data->vaccines.first;     
-        while(pVaccineNode != NULL && !appointment_created) {
-            // Check availability
-            if (api_checkAvailability(*data, pCenter->cp, pVaccineNode->vaccine.name, timestamp.date)) {
-                // Add appointments
-                api_addAppointment(data, pCenter->cp, document, pVaccineNode->vaccine.name, timestamp);
-                
-                // Update the stock
-                api_updateAppointmentStock(pCenter, pPerson);                
-                
-                // Set flag to end with search block
-                appointment_created = true;
-            }
-            
-            // Move to next vaccine
-            pVaccineNode = pVaccineNode->next;
+    // If no appointment is created, wait for new lots on this center and return error.
+    if (!api_bookFirstAvailable(data, pCenter, document, timestamp)) {
+        if (population_getBooking(&(data->population), person_idx)->waitingId != pCenter->cpId) {
+            waitlist_push(&(pCenter->waitlist), person_idx, data->population.elems[person_idx].birthday, timestamp);
+            population_setWaiting(&(data->population), person_idx, pCenter->cpId);
         }
-            
-        // Move to next day
-        dateTime_addDay(&timestamp, 1);        
-    }
-    
-    // Week 2: Assign first available vaccine
-    for(day=0; day < 7 && !appointment_created; day++) {
-        // We will try for each available vaccine (it is possible to limit to the available vaccines in center stock)
-        pVaccineNode = data->vaccines.first;             
-        while(pVaccineNode != NULL && !appointment_created) {
-            // Check doses for this vaccine and date
-            if (stockList_getDoses(&(pCenter->stock), timestamp.date, &(pVaccineNode->vaccine)) > 0) {
-                // Add appointments
-                api_addAppointment(data, pCenter->cp, document, pVaccineNode->vaccine.name, timestamp);
-                
-                // Update the stock
-                api_updateAppointmentStock(pCenter, pPerson);                
-                
-                // Set flag to end with search block
-                appointment_created = true;
+        return E_NO_VACCINES;
+    }
+    
+    return E_SUCCESS; 
+    /////////////////////////////////
+    // return E_NOT_IMPLEMENTED; 
+}
+
+// Reserve the stock and the slots of all the doses of a vaccine for a person during the given minutes from now. The identifier of the hold is stored on hold. E_DUPLICATED_PERSON if the person is booked or has an active hold
+tApiError api_holdAppointment(tApiData* data, const char* cp, const char* document, const char* vaccine, tDateTime timestamp, tDateTime now, int minutes, int* hold) {
+    tHealthCenter *pCenter = NULL;
+    tVaccine *pVaccine = NULL;
+    tDoseSeries series;
+    tDateTimeKey expiry;
+    tDateTime expiryTime;
+    int person_idx;
+    
+    // Check input data    
+    assert(data != NULL);
+    assert(cp != NULL);
+    assert(document != NULL);
+    assert(vaccine != NULL);
+    assert(hold != NULL);
+    assert(minutes > 0);
+    
+    // Release the holds expired before now
+    api_expireHolds(data, now);
+    
+    // Search person
+    person_idx = population_find(data->population, document);
+    if (person_idx < 0) {
+        return E_PERSON_NOT_FOUND;
+    }
+    // A person can only hold one booking, and only if it is not booked
+    if (population_isBooked(&(data->population), person_idx) || population_getBooking(&(data->population), person_idx)->hold >= 0) {
+        return E_DUPLICATED_PERSON;
+    }
+    
+    // Search vaccine
+    pVaccine = vaccineList_find(data->vaccines, vaccine);    
+    if (pVaccine == NULL) {
+        return E_VACCINE_NOT_FOUND;
+    }
+    
+    // Search the health center
+    pCenter = centerList_find(&(data->centers), cp);
+    if (pCenter == NULL) {
+        return E_HEALTH_CENTER_NOT_FOUND;
+    }
+    
+    // All the doses must be available, on a free slot
+    if (!api_checkAvailability(*data, cp, vaccine, timestamp.date) || !api_findSlot(pCenter, pVaccine, &timestamp)) {
+        return E_NO_VACCINES;
+    }
+    
+    // Reserve the doses and their slots until the expiry
+    doseSeries_init(&series, person_idx, pVaccine, timestamp);
+    api_updateAppointmentStock(pCenter, &series, -1);
+    api_updateAppointmentSlots(pCenter, &series, 1);
+    expiry = dateTime_toKey(now) + minutes;
+    dateTime_fromKey(&expiryTime, expiry);
+    *hold = holdWheel_add(data->holds, pCenter, series, expiryTime);
+    population_setHold(&(data->population), person_idx, *hold);
+    
+    return E_SUCCESS;
+}
+
+// Book the vaccination appointments reserved by a hold. If the booking fails the hold is kept
+tApiError api_confirmHold(tApiData* data, int hold) {
+    tHold *pHold = NULL;
+    tHealthCenter *pCenter = NULL;
+    tDoseSeries series;
+    tApiError error;
+    
+    assert(data != NULL);
+    
+    pHold = holdWheel_get(data->holds, hold);
+    if (pHold == NULL) {
+        return E_HOLD_NOT_FOUND;
+    }
+    pCenter = pHold->center;
+    series = pHold->series;
+    
+    // The booking takes the doses and the slots again
+    api_returnHoldStock(pHold, data);
+    error = api_addAppointment(data, pCenter->cp, data->population.elems[series.person].document, series.vaccine->name, series.first);
+    if (error != E_SUCCESS) {
+        // Keep the reservation of the hold
+        api_updateAppointmentStock(pCenter, &series, -1);
+        api_updateAppointmentSlots(pCenter, &series, 1);
+        population_setHold(&(data->population), series.person, hold);
+        return error;
+    }
+    holdWheel_remove(data->holds, hold);
+    
+    return E_SUCCESS;
+}
+
+// Return the reserved stock and slots of a hold to the center
+tApiError api_releaseHold(tApiData* data, int hold) {
+    tHold *pHold = NULL;
+    
+    assert(data != NULL);
+    
+    pHold = holdWheel_get(data->holds, hold);
+    if (pHold == NULL) {
+        return E_HOLD_NOT_FOUND;
+    }
+    
+    api_returnHoldStock(pHold, data);
+    holdWheel_remove(data->holds, hold);
+    
+    return E_SUCCESS;
+}
+
+// Return the stock and the slots of the holds expired at the given time. Return the number of expired holds
+int api_expireHolds(tApiData* data, tDateTime now) {
+    assert(data != NULL);
+    
+    return holdWheel_advance(data->holds, now, api_returnHoldStock, data);
+}
+
+// [AUX METHOD] Return the stock and the slots of a hold. The context is the API data, where the person stops holding them
+void api_returnHoldStock(tHold* hold, void* context) {
+    tApiData *pData = (tApiData*) context;
+    
+    assert(hold != NULL);
+    assert(pData != NULL);
+    
+    api_updateAppointmentStock(hold->center, &(hold->series), 1);
+    api_updateAppointmentSlots(hold->center, &(hold->series), -1);
+    population_setHold(&(pData->population), hold->series.person, -1);
+}
+
+// [AUX METHOD] Book the first available vaccine on the two weeks from the timestamp. Return false if there is no stock
+bool api_bookFirstAvailable(tApiData* data, tHealthCenter* center, const char* document, tDateTime timestamp) {
+    tVaccineNode *pVaccineNode = NULL;
+    tVaccine *pVaccine = NULL;
+    tDateTime slotTime;
+    tDateTime bookTime;
+    tDate last;
+    int week;
+    
+    assert(data != NULL);
+    assert(center != NULL);
+    assert(document != NULL);
+    
+    // Week 1: Assign only if availability is complete. Week 2: Assign first available vaccine
+    for (week = 0; week < 2 && pVaccine == NULL; week++) {
+        last = timestamp.date;
+        date_addDay(&last, 6);
+        
+        // Search the first day of each vaccine. On the same day, the first vaccine of the list is used
+        pVaccineNode = data->vaccines.first;
+        while (pVaccineNode != NULL) {
+            slotTime = timestamp;
+            if (api_findFirstBookable(center, &(pVaccineNode->vaccine), &slotTime, last, week == 0) && 
+                (pVaccine == NULL || date_cmp(slotTime.date, bookTime.date) < 0)) {
+                pVaccine = &(pVaccineNode->vaccine);
+                bookTime = slotTime;
             }
             
             // Move to next vaccine
             pVaccineNode = pVaccineNode->next;
         }
         
-        // Move to next day
-        dateTime_addDay(&timestamp, 1); 
+        // Move to next week
+        dateTime_addDay(&timestamp, 7);
     }
-
-    // If no appointment is created, return error.
-    if (!appointment_created) {
-        return E_NO_VACCINES;
+    
+    if (pVaccine == NULL) {
+        return false;
     }
     
-    return E_SUCCESS; 
-    /////////////////////////////////
-    // return E_NOT_IMPLEMENTED; 
+    // Add appointments. The doses are taken from the stock
+    api_addAppointment(data, center->cp, document, pVaccine->name, bookTime);
+
+    return true;
 }
 
-// [AUX METHOD] Update stock with person appointments
-void api_updateAppointmentStock(tHealthCenter* center, tPerson* person) {
-    int appointment_idx = 0;
-    tAppointment *pAppointment = NULL;
+// [AUX METHOD] Move the timestamp to the first day until last with stock and a free slot for a vaccine. If complete is true all the doses must be available, otherwise only the first one. Return false if there is none
+bool api_findFirstBookable(tHealthCenter* center, tVaccine* vaccine, tDateTime* timestamp, tDate last, bool complete) {
+    tDateTime slotTime;
+    tDate date;
+    bool found;
     
-    appointment_idx = appointmentData_find(center->appointments, person, appointment_idx);
-    while(appointment_idx >= 0 ) {
-        // Get a pointer to the appointment for convenience
-        pAppointment = &(center->appointments.elems[appointment_idx]);
+    assert(center != NULL);
+    assert(vaccine != NULL);
+    assert(timestamp != NULL);
+    
+    date = timestamp->date;
+    while (true) {
+        // Jump to the next day with stock instead of checking the days one by one
+        if (complete) {
+            found = stockList_findFirstSeries(&(center->stock), date, vaccine, 1, &date);
+        } else {
+            found = stockList_findFirst(&(center->stock), date, vaccine, 1, &date);
+        }
+        if (!found || date_cmp(date, last) > 0) {
+            return false;
+        }
         
-        // Reduce the number of doses by one        
-        stockList_update(&(center->stock), pAppointment->timestamp.date, pAppointment->vaccine, -1);
+        // The search of slots starts at the requested time on each day
+        slotTime = *timestamp;
+        slotTime.date = date;
+        if (api_findSlot(center, vaccine, &slotTime)) {
+            *timestamp = slotTime;
+            return true;
+        }
+        date_addDay(&date, 1);
+    }
+}
+
+// [AUX METHOD] Book the persons waiting on a center, from the one with the highest priority. Persons without stock keep waiting. Return the number of booked persons
+int api_backfillWaitlist(tApiData* data, tHealthCenter* center, tDateTime arrival) {
+    tWaitlistEntry entry;
+    tWaitlistEntry* pending;
+    tDateTime timestamp;
+    int pendingCount;
+    int person_idx;
+    int booked;
+    int i;
+    
+    assert(data != NULL);
+    assert(center != NULL);
+    
+    if (waitlist_len(center->waitlist) == 0) {
+        return 0;
+    }
+    
+    // Requests that can not be booked are added again after the pass
+    pending = (tWaitlistEntry*) malloc(waitlist_len(center->waitlist) * sizeof(tWaitlistEntry));
+    assert(pending != NULL);
+    pendingCount = 0;
+    booked = 0;
+    
+    while (waitlist_pop(&(center->waitlist), &entry)) {
+        person_idx = entry.person;
+        assert(person_idx >= 0 && person_idx < data->population.count);
         
-        // Move to next appointment
-        appointment_idx = appointmentData_find(center->appointments, person, appointment_idx + 1);
+        // Skip requests of persons booked meanwhile or waiting on another center
+        if (population_isBooked(&(data->population), person_idx) || 
+            population_getBooking(&(data->population), person_idx)->waitingId != center->cpId) {
+            continue;
+        }
+        
+        // Search from the requested timestamp, or the arrival of the lot if it is later
+        timestamp = entry.timestamp;
+        if (date_cmp(arrival.date, timestamp.date) > 0) {
+            timestamp.date = arrival.date;
+        }
+        if (api_bookFirstAvailable(data, center, data->population.elems[person_idx].document, timestamp)) {
+            booked++;
+        } else {
+            pending[pendingCount] = entry;
+            pendingCount++;
+        }
+    }
+    
+    for (i = 0; i < pendingCount; i++) {
+        waitlist_push(&(center->waitlist), pending[i].person, data->population.elems[pending[i].person].birthday, pending[i].timestamp);
+    }
+    free(pending);
+    
+    return booked;
+}
+
+// Cancel the vaccination appointments of a person, returning their doses to the center stock
+tApiError api_cancelAppointment(tApiData* data, const char* document) {
+    const tPersonBooking *pBooking = NULL;
+    tHealthCenter *pCenter = NULL;
+    int person_idx;
+    int moved_idx;
+    int series_idx;
+    
+    // Check input data    
+    assert(data != NULL);
+    assert(document != NULL);
+    
+    // Search person and its booking
+    person_idx = population_find(data->population, document);
+    if (person_idx < 0) {
+        return E_PERSON_NOT_FOUND;
+    }
+    pBooking = population_getBooking(&(data->population), person_idx);
+    if (pBooking->doses == 0) {
+        return E_APPOINTMENT_NOT_FOUND;
+    }
+    pCenter = centerList_findById(&(data->centers), pBooking->centerId);
+    assert(pCenter != NULL);
+    series_idx = pBooking->series;
+    
+    // Return the doses and the slots and remove the series
+    api_updateAppointmentStock(pCenter, &(pCenter->series.elems[series_idx]), 1);
+    api_updateAppointmentSlots(pCenter, &(pCenter->series.elems[series_idx]), -1);
+    doseSeriesData_remove(&(pCenter->series), series_idx);
+    population_clearBooking(&(data->population), person_idx);
+    
+    // The last series of the center was moved to the released position
+    if (series_idx < pCenter->series.count) {
+        moved_idx = pCenter->series.elems[series_idx].person;
+        assert(moved_idx >= 0 && moved_idx < data->population.count);
+        data->population.bookings[moved_idx].series = series_idx;
+    }
+    
+    return E_SUCCESS;
+}
+
+// Remove a person, cancelling its appointments, holds and requests. The positions of the next persons are updated on all the centers
+tApiError api_deletePerson(tApiData* data, const char* document) {
+    tHealthCenterNode *pNode = NULL;
+    tHold *pHold = NULL;
+    int person_idx;
+    int i;
+    
+    // Check input data
+    assert(data != NULL);
+    assert(document != NULL);
+    
+    person_idx = population_find(data->population, document);
+    if (person_idx < 0) {
+        return E_PERSON_NOT_FOUND;
+    }
+    
+    // Return the stock and the slots of its appointments
+    if (population_isBooked(&(data->population), person_idx)) {
+        api_cancelAppointment(data, document);
+    }
+    
+    // Release its holds. The holds of the next persons move one position down
+    for (i = 0; i < data->holds->count; i++) {
+        pHold = holdWheel_get(data->holds, i);
+        if (pHold != NULL && pHold->series.person == person_idx) {
+            api_returnHoldStock(pHold, data);
+            holdWheel_remove(data->holds, i);
+        } else if (pHold != NULL && pHold->series.person > person_idx) {
+            pHold->series.person--;
+        }
+    }
+    
+    // Remove its requests. The series and requests of the next persons move one position down
+    pNode = data->centers.first;
+    while (pNode != NULL) {
+        doseSeriesData_delPerson(&(pNode->elem.series), person_idx);
+        waitlist_delPerson(&(pNode->elem.waitlist), person_idx);
+        pNode = pNode->next;
+    }
+    
+    population_del(&(data->population), document);
+    
+    return E_SUCCESS;
+}
+
+// Move the vaccination appointments of a person to a new first dose timestamp on the same center and vaccine. On centers with a slot limit, the first free slot of the day from the timestamp is used
+tApiError api_rescheduleAppointment(tApiData* data, const char* document, tDateTime timestamp) {
+    const tPersonBooking *pBooking = NULL;
+    tHealthCenter *pCenter = NULL;
+    tDoseSeries *pSeries = NULL;
+    int person_idx;
+    
+    // Check input data    
+    assert(data != NULL);
+    assert(document != NULL);
+    
+    // Search person and its booking
+    person_idx = population_find(data->population, document);
+    if (person_idx < 0) {
+        return E_PERSON_NOT_FOUND;
+    }
+    pBooking = population_getBooking(&(data->population), person_idx);
+    if (pBooking->doses == 0) {
+        return E_APPOINTMENT_NOT_FOUND;
+    }
+    pCenter = centerList_findById(&(data->centers), pBooking->centerId);
+    assert(pCenter != NULL);
+    pSeries = &(pCenter->series.elems[pBooking->series]);
+    
+    // Return the current doses and slots, so they can be used by the new dates
+    api_updateAppointmentStock(pCenter, pSeries, 1);
+    api_updateAppointmentSlots(pCenter, pSeries, -1);
+    
+    // The new dates need stock and a free slot for all the doses
+    if (!api_checkAvailability(*data, pCenter->cp, pSeries->vaccine->name, timestamp.date) || !api_findSlot(pCenter, pSeries->vaccine, &timestamp)) {
+        // Keep the current appointments
+        api_updateAppointmentStock(pCenter, pSeries, -1);
+        api_updateAppointmentSlots(pCenter, pSeries, 1);
+        return E_NO_VACCINES;
+    }
+    
+    // Take the doses and the slots of the new dates
+    pSeries->first = timestamp;
+    api_updateAppointmentStock(pCenter, pSeries, -1);
+    api_updateAppointmentSlots(pCenter, pSeries, 1);
+    
+    return E_SUCCESS;
+}
+
+// [AUX METHOD] Move the timestamp to the first slot of its day that is free for all the doses of the vaccine. Return false if there is none
+bool api_findSlot(tHealthCenter* center, tVaccine* vaccine, tDateTime* timestamp) {
+    int slot;
+    
+    assert(center != NULL);
+    assert(vaccine != NULL);
+    assert(timestamp != NULL);
+    
+    // Centers without limit keep the requested time
+    if (center->slots.capacity == 0) {
+        return true;
+    }
+    
+    slot = slotCalendar_findFirst(&(center->slots), date_toDays(timestamp->date), vaccine->days, vaccine->required, slot_fromTime(timestamp->time));
+    if (slot == SLOT_NOT_FOUND) {
+        return false;
+    }
+    timestamp->time = slot_toTime(slot);
+    
+    return true;
+}
+
+// [AUX METHOD] Add appointments to the slots of the doses of a series. Negative values remove them
+void api_updateAppointmentSlots(tHealthCenter* center, tDoseSeries* series, int appointments) {
+    int dose;
+    
+    assert(center != NULL);
+    assert(series != NULL);
+    
+    for (dose = 0; dose < series->doses; dose++) {
+        slotCalendar_update(&(center->slots), doseSeries_getDose(*series, dose), appointments);
+    }
+}
+
+// [AUX METHOD] Update stock with the doses of a series, adding the given number of doses for each one
+void api_updateAppointmentStock(tHealthCenter* center, tDoseSeries* series, int doses) {
+    int dose;
+    
+    assert(center != NULL);
+    assert(series != NULL);
+    
+    for (dose = 0; dose < series->doses; dose++) {
+        stockList_adjust(&(center->stock), doseSeries_getDose(*series, dose).date, series->vaccine, doses);
+    }
+}
+
+// [AUX METHOD] Get the names of the vaccines in list order. The array must be released, but not the names
+char** api_getVaccineNames(tApiData data) {
+    tVaccineNode *pNode = NULL;
+    char** names;
+    int i;
+    
+    names = (char**) malloc((data.vaccines.count > 0 ? data.vaccines.count : 1) * sizeof(char*));
+    assert(names != NULL);
+    
+    i = 0;
+    for (pNode = data.vaccines.first; pNode != NULL; pNode = pNode->next) {
+        names[i++] = pNode->vaccine.name;
     }
+    
+    return names;
+}
+
+// [AUX METHOD] Get the position of a vaccine in the vaccine list
+int api_getVaccineCode(tApiData data, const tVaccine* vaccine) {
+    tVaccineNode *pNode = NULL;
+    int code = 0;
+    
+    for (pNode = data.vaccines.first; pNode != NULL; pNode = pNode->next) {
+        if (&(pNode->vaccine) == vaccine) {
+            return code;
+        }
+        code++;
+    }
+    
+    assert(false);
+    return -1;
 }
\ No newline at end of file
@@ -18,8 +18,10 @@ void appointmentData_insert(tAppointmentData* list, tDateTime timestamp, tVaccin
     //////////////////////////////////
     // Ex PR3 1b
     /////////////////////////////////
-    int insert_pos = -1;
-    int i;
+    tDateTimeKey key;
+    int insert_pos;
+    int high;
+    int mid;
     
     // Check input data
     assert(list != NULL);
@@ -36,31 +38,29 @@ void appointmentData_insert(tAppointmentData* list, tDateTime timestamp, tVaccin
     }
     assert(list->elems != NULL);
     
-    // Search insertion point
-    for(i=0; i < list->count && insert_pos < 0; i++) {        
-        // Check the date and time
-        if(dateTime_cmp(timestamp, list->elems[i].timestamp) < 0 || 
-            (dateTime_cmp(timestamp, list->elems[i].timestamp) == 0 && strcmp(person->document, list->elems[i].person->document) < 0)) {
-            // This is the insertion position
-            insert_pos = i;
+    // Binary search of the insertion point: after all the elements with an earlier or equal timestamp and document
+    key = dateTime_toKey(timestamp);
+    insert_pos = 0;
+    high = list->count;
+    while (insert_pos < high) {
+        mid = (insert_pos + high) / 2;
+        if (key < list->elems[mid].key || (key == list->elems[mid].key && 
+            document_cmp(person->key, person->document, list->elems[mid].person->key, list->elems[mid].person->document) < 0)) {
+            high = mid;
+        } else {
+            insert_pos = mid + 1;
         }
     }
     
-    // In case insertion point is not found, set as last element
-    if(insert_pos < 0) { 
-        insert_pos = list->count;
-    }
+    // Displace all elements from the insertion position to the end
+    memmove(&(list->elems[insert_pos + 1]), &(list->elems[insert_pos]), (list->count - insert_pos) * sizeof(tAppointment));
     
     // Increase the size of the list
     list->count += 1;
-            
-    // Displace all elements from end to the insertion position    
-    for(i=list->count - 1; i>insert_pos; i--) {
-        list->elems[i] = list->elems[i-1];
-    }            
     
     // Finally add the new element
     list->elems[insert_pos].timestamp = timestamp;
+    list->elems[insert_pos].key = key;
     list->elems[insert_pos].person = person;
     list->elems[insert_pos].vaccine = vaccine;
 }
@@ -70,27 +70,24 @@ void appointmentData_remove(tAppointmentData* list, tDateTime timestamp, tPerson
     //////////////////////////////////
     // Ex PR3 1c
     /////////////////////////////////
-    bool found = false;
-    int i;
+    tDateTimeKey key;
+    int pos;
     
     // Check input data
     assert(list != NULL);
     assert(person != NULL);
     
-    // Transverse the list of appointments and displace in case element is found
-    for(i=0; i < list->count; i++) {
-        // Check if current element is the element we are looking for
-        if ( dateTime_equals(list->elems[i].timestamp, timestamp) && strcmp(list->elems[i].person->document, person->document) == 0) {
-            found = true;
-        }
-        // If the element is found, make a displacement
-        if (found && i < (list->count - 1) ) {
-            list->elems[i] = list->elems[i+1];
-        }
+    // Search the appointment among the ones with the same timestamp
+    key = dateTime_toKey(timestamp);
+    pos = appointmentData_lowerBound(*list, key);
+    while (pos < list->count && list->elems[pos].key == key && 
+           !document_equals(list->elems[pos].person->key, list->elems[pos].person->document, person->key, person->document)) {
+        pos++;
     }
     
-    // In case the element was found, resize the elements
-    if (found) {
+    // In case the element was found, displace the next elements and resize
+    if (pos < list->count && list->elems[pos].key == key) {
+        memmove(&(list->elems[pos]), &(list->elems[pos + 1]), (list->count - pos - 1) * sizeof(tAppointment));
         list->count--;
         if (list->count == 0) {
             // Empty list
@@ -118,7 +115,7 @@ int appointmentData_find(tAppointmentData list, tPerson* person, int start_pos)
     if (start_pos >= list.count) {
         // Trivial case 1: Start position larger than number of elements
         pos = -1;
-    } else if(strcmp(list.elems[start_pos].person->document, person->document) == 0) {
+    } else if(document_equals(list.elems[start_pos].person->key, list.elems[start_pos].person->document, person->key, person->document)) {
         // Trivial case 2: Current position is the element we are looking for
         pos = start_pos;
     } else {
@@ -142,3 +139,165 @@ void appointmentData_free(tAppointmentData* list) {
     list->elems = NULL;
     list->count = 0;
 }
+
+// [AUX METHOD] Get the position of the first appointment with a timestamp not before the given key
+int appointmentData_lowerBound(tAppointmentData list, tDateTimeKey key) {
+    int low;
+    int high;
+    int mid;
+    
+    low = 0;
+    high = list.count;
+    while (low < high) {
+        mid = (low + high) / 2;
+        if (list.elems[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+// Initialize a dose series with all the doses of the vaccine for the person on the given position
+void doseSeries_init(tDoseSeries* series, int person, tVaccine* vaccine, tDateTime first) {
+    assert(series != NULL);
+    assert(person >= 0);
+    assert(vaccine != NULL);
+    
+    series->person = person;
+    series->vaccine = vaccine;
+    series->first = first;
+    series->doses = vaccine->required;
+    series->interval = vaccine->days;
+}
+
+// Get the timestamp of a dose of the series. The first dose is 0
+tDateTime doseSeries_getDose(tDoseSeries series, int dose) {
+    tDateTime timestamp;
+    
+    assert(dose >= 0 && dose < series.doses);
+    
+    timestamp = series.first;
+    dateTime_addDay(&timestamp, dose * series.interval);
+    
+    return timestamp;
+}
+
+// Call the visitor for each dose of the series, from the first one. Persons are taken from the given array. Return the number of visited appointments
+int doseSeries_visit(const tDoseSeries* series, tPerson* persons, const char* cp, tAppointmentVisitor visitor, void* context) {
+    tAppointment appointment;
+    int dose;
+    
+    assert(series != NULL);
+    assert(persons != NULL);
+    assert(visitor != NULL);
+    
+    appointment.person = &(persons[series->person]);
+    appointment.vaccine = series->vaccine;
+    for (dose = 0; dose < series->doses; dose++) {
+        appointment.timestamp = doseSeries_getDose(*series, dose);
+        appointment.key = dateTime_toKey(appointment.timestamp);
+        visitor(&appointment, cp, context);
+    }
+    
+    return series->doses;
+}
+
+// Initializes a dose series list
+void doseSeriesData_init(tDoseSeriesData* list) {
+    assert(list != NULL);
+    
+    list->elems = NULL;
+    list->count = 0;
+}
+
+// Add a dose series at the end of the list. Return its position
+int doseSeriesData_add(tDoseSeriesData* list, tDoseSeries series) {
+    assert(list != NULL);
+    
+    // Allocate memory for new element
+    if (list->count == 0) {
+        list->elems = (tDoseSeries*) malloc(sizeof(tDoseSeries));
+    } else {
+        list->elems = (tDoseSeries*) realloc(list->elems, (list->count + 1) * sizeof(tDoseSeries));
+    }
+    assert(list->elems != NULL);
+    
+    list->elems[list->count] = series;
+    list->count++;
+    
+    return list->count - 1;
+}
+
+// Remove the dose series on the given position. The last one is moved to this position
+void doseSeriesData_remove(tDoseSeriesData* list, int pos) {
+    assert(list != NULL);
+    assert(pos >= 0 && pos < list->count);
+    
+    list->elems[pos] = list->elems[list->count - 1];
+    list->count--;
+    if (list->count == 0) {
+        // Empty list
+        free(list->elems);
+        list->elems = NULL;
+    } else {
+        // Modify currently allocated memory
+        list->elems = (tDoseSeries*) realloc(list->elems, list->count * sizeof(tDoseSeries));
+        assert(list->elems != NULL);
+    }
+}
+
+// Update the person positions after the person on the given position is removed from the population. The person must not have series on the list
+void doseSeriesData_delPerson(tDoseSeriesData* list, int person) {
+    int i;
+    
+    assert(list != NULL);
+    assert(person >= 0);
+    
+    for (i = 0; i < list->count; i++) {
+        assert(list->elems[i].person != person);
+        if (list->elems[i].person > person) {
+            list->elems[i].person--;
+        }
+    }
+}
+
+// Insert all the doses of the list on a vaccination appointment list. Persons are taken from the given array
+void doseSeriesData_expand(tDoseSeriesData list, tPerson* persons, tAppointmentData* appointments) {
+    int i;
+    int dose;
+    
+    assert(persons != NULL || list.count == 0);
+    assert(appointments != NULL);
+    
+    for (i = 0; i < list.count; i++) {
+        for (dose = 0; dose < list.elems[i].doses; dose++) {
+            appointmentData_insert(appointments, doseSeries_getDose(list.elems[i], dose), list.elems[i].vaccine, &(persons[list.elems[i].person]));
+        }
+    }
+}
+
+// Call the visitor for each dose of all the series of the list, in booking order. Persons are taken from the given array. Return the number of visited appointments
+int doseSeriesData_visit(tDoseSeriesData list, tPerson* persons, const char* cp, tAppointmentVisitor visitor, void* context) {
+    int count = 0;
+    int i;
+    
+    for (i = 0; i < list.count; i++) {
+        count += doseSeries_visit(&(list.elems[i]), persons, cp, visitor, context);
+    }
+    
+    return count;
+}
+
+// Release a dose series list
+void doseSeriesData_free(tDoseSeriesData* list) {
+    assert(list != NULL);
+    
+    if (list->elems != NULL) {
+        free(list->elems);
+    }
+    list->elems = NULL;
+    list->count = 0;
+}
@@ -0,0 +1,86 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+// Initialize the arena
+void stringArena_init(tStringArena* arena) {
+    assert(arena != NULL);
+    
+    arena->first = NULL;
+    arena->used = 0;
+    arena->blocks = 0;
+}
+
+// Release all the strings stored on the arena
+void stringArena_free(tStringArena* arena) {
+    tStringArenaBlock *pBlock;
+    tStringArenaBlock *pAux;
+    
+    assert(arena != NULL);
+    
+    // Remove the blocks, not the strings one by one
+    pBlock = arena->first;
+    while(pBlock != NULL) {
+        pAux = pBlock;
+        pBlock = pBlock->next;
+        free(pAux);
+    }
+    
+    stringArena_init(arena);
+}
+
+// Get space for a string of the given length, including the ending character
+char* stringArena_alloc(tStringArena* arena, size_t length) {
+    tStringArenaBlock *pBlock;
+    size_t size;
+    char *str;
+    
+    assert(arena != NULL);
+    
+    // Open a new block when the current one is full. Long strings get their own block
+    pBlock = arena->first;
+    if (pBlock == NULL || pBlock->size - pBlock->used < length) {
+        size = length > STRING_ARENA_BLOCK_SIZE ? length : STRING_ARENA_BLOCK_SIZE;
+        pBlock = (tStringArenaBlock*) malloc(sizeof(tStringArenaBlock) + size);
+        assert(pBlock != NULL);
+        pBlock->size = size;
+        pBlock->used = 0;
+        pBlock->next = arena->first;
+        arena->first = pBlock;
+        arena->blocks++;
+    }
+    
+    // Bump the pointer
+    str = &(pBlock->data[pBlock->used]);
+    pBlock->used += length;
+    arena->used += length;
+    
+    return str;
+}
+
+// Copy a string. If arena is NULL the copy is allocated with malloc
+char* stringArena_strdup(tStringArena* arena, const char* str) {
+    size_t length;
+    char *copy;
+    
+    assert(str != NULL);
+    
+    length = strlen(str) + 1;
+    if (arena == NULL) {
+        copy = (char*) malloc(length);
+        assert(copy != NULL);
+    } else {
+        copy = stringArena_alloc(arena, length);
+    }
+    memcpy(copy, str, length);
+    
+    return copy;
+}
+
+// Get the number of bytes used by the stored strings
+size_t stringArena_size(tStringArena* arena) {
+    assert(arena != NULL);
+    
+    return arena->used;
+}
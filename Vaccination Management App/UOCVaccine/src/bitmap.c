@@ -0,0 +1,522 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitmap.h"
+
+// Initialize an empty bitmap
+void bitmap_init(tBitmap* bitmap) {
+    assert(bitmap != NULL);
+    
+    bitmap->containers = NULL;
+    bitmap->count = 0;
+}
+
+// Release the bitmap data
+void bitmap_free(tBitmap* bitmap) {
+    int i;
+    
+    assert(bitmap != NULL);
+    
+    for (i = 0; i < bitmap->count; i++) {
+        if (bitmap->containers[i].values != NULL) {
+            free(bitmap->containers[i].values);
+        }
+        if (bitmap->containers[i].bits != NULL) {
+            free(bitmap->containers[i].bits);
+        }
+    }
+    if (bitmap->containers != NULL) {
+        free(bitmap->containers);
+    }
+    bitmap_init(bitmap);
+}
+
+// Copy the source bitmap to an initialized destination, replacing its values
+void bitmap_cpy(tBitmap* destination, const tBitmap* source) {
+    tBitmapContainer *pContainer;
+    int i;
+    
+    assert(destination != NULL);
+    assert(source != NULL);
+    
+    if (destination == source) {
+        return;
+    }
+    bitmap_free(destination);
+    if (source->count == 0) {
+        return;
+    }
+    
+    destination->containers = (tBitmapContainer*) malloc(source->count * sizeof(tBitmapContainer));
+    assert(destination->containers != NULL);
+    destination->count = source->count;
+    for (i = 0; i < source->count; i++) {
+        pContainer = &(destination->containers[i]);
+        *pContainer = source->containers[i];
+        if (pContainer->values != NULL) {
+            pContainer->values = (uint16_t*) malloc(pContainer->capacity * sizeof(uint16_t));
+            assert(pContainer->values != NULL);
+            memcpy(pContainer->values, source->containers[i].values, pContainer->cardinality * sizeof(uint16_t));
+        }
+        if (pContainer->bits != NULL) {
+            pContainer->bits = (uint64_t*) malloc(BITMAP_BITSET_WORDS * sizeof(uint64_t));
+            assert(pContainer->bits != NULL);
+            memcpy(pContainer->bits, source->containers[i].bits, BITMAP_BITSET_WORDS * sizeof(uint64_t));
+        }
+    }
+}
+
+// Get the position of the container with the given key. If it does not exist, -(insertion position + 1)
+int bitmap_findContainer(const tBitmap* bitmap, uint16_t key) {
+    int low;
+    int high;
+    int mid;
+    
+    // Binary search, checking first the last container since values are usually added in order
+    if (bitmap->count > 0 && bitmap->containers[bitmap->count - 1].key == key) {
+        return bitmap->count - 1;
+    }
+    low = 0;
+    high = bitmap->count;
+    while (low < high) {
+        mid = (low + high) / 2;
+        if (bitmap->containers[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    if (low < bitmap->count && bitmap->containers[low].key == key) {
+        return low;
+    }
+    return -(low + 1);
+}
+
+// Get the position of the first value of an array container not lower than the given one
+int bitmap_arrayPos(const tBitmapContainer* container, uint16_t low) {
+    int low_pos;
+    int high_pos;
+    int mid;
+    
+    // Values are usually added in order
+    if (container->cardinality == 0 || container->values[container->cardinality - 1] < low) {
+        return container->cardinality;
+    }
+    
+    // Binary search on the array
+    low_pos = 0;
+    high_pos = container->cardinality;
+    while (low_pos < high_pos) {
+        mid = (low_pos + high_pos) / 2;
+        if (container->values[mid] < low) {
+            low_pos = mid + 1;
+        } else {
+            high_pos = mid;
+        }
+    }
+    
+    return low_pos;
+}
+
+// Insert an empty array container on the given position
+tBitmapContainer* bitmap_insertContainer(tBitmap* bitmap, int pos, uint16_t key) {
+    tBitmapContainer *pContainer;
+    
+    bitmap->containers = (tBitmapContainer*) realloc(bitmap->containers, (bitmap->count + 1) * sizeof(tBitmapContainer));
+    assert(bitmap->containers != NULL);
+    memmove(&(bitmap->containers[pos + 1]), &(bitmap->containers[pos]), (bitmap->count - pos) * sizeof(tBitmapContainer));
+    bitmap->count++;
+    
+    pContainer = &(bitmap->containers[pos]);
+    pContainer->key = key;
+    pContainer->cardinality = 0;
+    pContainer->values = NULL;
+    pContainer->capacity = 0;
+    pContainer->bits = NULL;
+    
+    return pContainer;
+}
+
+// Remove the container on the given position
+void bitmap_removeContainer(tBitmap* bitmap, int pos) {
+    if (bitmap->containers[pos].values != NULL) {
+        free(bitmap->containers[pos].values);
+    }
+    if (bitmap->containers[pos].bits != NULL) {
+        free(bitmap->containers[pos].bits);
+    }
+    memmove(&(bitmap->containers[pos]), &(bitmap->containers[pos + 1]), (bitmap->count - pos - 1) * sizeof(tBitmapContainer));
+    bitmap->count--;
+    if (bitmap->count == 0) {
+        free(bitmap->containers);
+        bitmap->containers = NULL;
+    }
+}
+
+// Add a value
+void bitmap_add(tBitmap* bitmap, uint32_t value) {
+    tBitmapContainer *pContainer;
+    uint16_t low;
+    int pos;
+    int i;
+    
+    assert(bitmap != NULL);
+    
+    pos = bitmap_findContainer(bitmap, (uint16_t)(value >> 16));
+    if (pos < 0) {
+        pContainer = bitmap_insertContainer(bitmap, -(pos + 1), (uint16_t)(value >> 16));
+    } else {
+        pContainer = &(bitmap->containers[pos]);
+    }
+    low = (uint16_t)(value & 0xFFFF);
+    
+    // Array containers are sorted
+    if (pContainer->bits == NULL) {
+        pos = bitmap_arrayPos(pContainer, low);
+        if (pos < pContainer->cardinality && pContainer->values[pos] == low) {
+            return;
+        }
+        
+        // Full arrays become bitsets
+        if (pContainer->cardinality == BITMAP_ARRAY_MAX) {
+            pContainer->bits = (uint64_t*) calloc(BITMAP_BITSET_WORDS, sizeof(uint64_t));
+            assert(pContainer->bits != NULL);
+            for (i = 0; i < pContainer->cardinality; i++) {
+                pContainer->bits[pContainer->values[i] >> 6] |= (uint64_t)1 << (pContainer->values[i] & 63);
+            }
+            free(pContainer->values);
+            pContainer->values = NULL;
+            pContainer->capacity = 0;
+        } else {
+            if (pContainer->cardinality == pContainer->capacity) {
+                pContainer->capacity = pContainer->capacity == 0 ? 4 : 2 * pContainer->capacity;
+                pContainer->values = (uint16_t*) realloc(pContainer->values, pContainer->capacity * sizeof(uint16_t));
+                assert(pContainer->values != NULL);
+            }
+            memmove(&(pContainer->values[pos + 1]), &(pContainer->values[pos]), (pContainer->cardinality - pos) * sizeof(uint16_t));
+            pContainer->values[pos] = low;
+            pContainer->cardinality++;
+            return;
+        }
+    }
+    
+    // Set the bit
+    if ((pContainer->bits[low >> 6] & ((uint64_t)1 << (low & 63))) == 0) {
+        pContainer->bits[low >> 6] |= (uint64_t)1 << (low & 63);
+        pContainer->cardinality++;
+    }
+}
+
+// Remove a value
+void bitmap_remove(tBitmap* bitmap, uint32_t value) {
+    tBitmapContainer *pContainer;
+    uint64_t word;
+    uint16_t low;
+    int pos;
+    int i;
+    int j;
+    
+    assert(bitmap != NULL);
+    
+    pos = bitmap_findContainer(bitmap, (uint16_t)(value >> 16));
+    if (pos < 0) {
+        return;
+    }
+    pContainer = &(bitmap->containers[pos]);
+    low = (uint16_t)(value & 0xFFFF);
+    
+    if (pContainer->bits == NULL) {
+        i = bitmap_arrayPos(pContainer, low);
+        if (i == pContainer->cardinality || pContainer->values[i] != low) {
+            return;
+        }
+        memmove(&(pContainer->values[i]), &(pContainer->values[i + 1]), (pContainer->cardinality - i - 1) * sizeof(uint16_t));
+        pContainer->cardinality--;
+    } else if ((pContainer->bits[low >> 6] & ((uint64_t)1 << (low & 63))) != 0) {
+        pContainer->bits[low >> 6] &= ~((uint64_t)1 << (low & 63));
+        pContainer->cardinality--;
+        
+        // Bitsets that become small are stored again as arrays. Half the limit avoids converting back and forth
+        if (pContainer->cardinality <= BITMAP_ARRAY_MAX / 2) {
+            pContainer->values = (uint16_t*) malloc(BITMAP_ARRAY_MAX * sizeof(uint16_t));
+            assert(pContainer->values != NULL);
+            pContainer->capacity = BITMAP_ARRAY_MAX;
+            j = 0;
+            for (i = 0; i < BITMAP_BITSET_WORDS; i++) {
+                for (word = pContainer->bits[i]; word != 0; word &= word - 1) {
+                    pContainer->values[j++] = (uint16_t)(i * 64 + __builtin_ctzll(word));
+                }
+            }
+            free(pContainer->bits);
+            pContainer->bits = NULL;
+        }
+    }
+    
+    if (pContainer->cardinality == 0) {
+        bitmap_removeContainer(bitmap, pos);
+    }
+}
+
+// Remove a value and decrease by one all the greater values
+void bitmap_removeShift(tBitmap* bitmap, uint32_t value) {
+    tBitmap shifted;
+    uint64_t words[BITMAP_BITSET_WORDS];
+    uint64_t word;
+    uint32_t current;
+    int i;
+    int j;
+    
+    assert(bitmap != NULL);
+    
+    // Values are added in increasing order, so each one is appended
+    bitmap_init(&shifted);
+    for (i = 0; i < bitmap->count; i++) {
+        bitmap_containerWords(&(bitmap->containers[i]), words);
+        for (j = 0; j < BITMAP_BITSET_WORDS; j++) {
+            for (word = words[j]; word != 0; word &= word - 1) {
+                current = ((uint32_t)bitmap->containers[i].key << 16) | (uint32_t)(j * 64 + __builtin_ctzll(word));
+                if (current < value) {
+                    bitmap_add(&shifted, current);
+                } else if (current > value) {
+                    bitmap_add(&shifted, current - 1);
+                }
+            }
+        }
+    }
+    
+    bitmap_free(bitmap);
+    *bitmap = shifted;
+}
+
+// Check if a value is on the bitmap
+bool bitmap_contains(const tBitmap* bitmap, uint32_t value) {
+    const tBitmapContainer *pContainer;
+    uint16_t low;
+    int pos;
+    
+    assert(bitmap != NULL);
+    
+    pos = bitmap_findContainer(bitmap, (uint16_t)(value >> 16));
+    if (pos < 0) {
+        return false;
+    }
+    pContainer = &(bitmap->containers[pos]);
+    low = (uint16_t)(value & 0xFFFF);
+    
+    if (pContainer->bits != NULL) {
+        return (pContainer->bits[low >> 6] >> (low & 63)) & 1;
+    }
+    pos = bitmap_arrayPos(pContainer, low);
+    return pos < pContainer->cardinality && pContainer->values[pos] == low;
+}
+
+// Get the number of values
+int bitmap_cardinality(const tBitmap* bitmap) {
+    int i;
+    int cardinality;
+    
+    assert(bitmap != NULL);
+    
+    cardinality = 0;
+    for (i = 0; i < bitmap->count; i++) {
+        cardinality += bitmap->containers[i].cardinality;
+    }
+    
+    return cardinality;
+}
+
+// Write the values of a container as a bitset
+void bitmap_containerWords(const tBitmapContainer* container, uint64_t* words) {
+    int i;
+    
+    if (container == NULL) {
+        memset(words, 0, BITMAP_BITSET_WORDS * sizeof(uint64_t));
+    } else if (container->bits != NULL) {
+        memcpy(words, container->bits, BITMAP_BITSET_WORDS * sizeof(uint64_t));
+    } else {
+        memset(words, 0, BITMAP_BITSET_WORDS * sizeof(uint64_t));
+        for (i = 0; i < container->cardinality; i++) {
+            words[container->values[i] >> 6] |= (uint64_t)1 << (container->values[i] & 63);
+        }
+    }
+}
+
+// Append a container with the values of a bitset, if it is not empty
+void bitmap_appendWords(tBitmap* bitmap, uint16_t key, const uint64_t* words) {
+    tBitmapContainer *pContainer;
+    uint64_t word;
+    int cardinality;
+    int i;
+    
+    cardinality = 0;
+    for (i = 0; i < BITMAP_BITSET_WORDS; i++) {
+        cardinality += __builtin_popcountll(words[i]);
+    }
+    if (cardinality == 0) {
+        return;
+    }
+    
+    pContainer = bitmap_insertContainer(bitmap, bitmap->count, key);
+    pContainer->cardinality = cardinality;
+    if (cardinality > BITMAP_ARRAY_MAX) {
+        pContainer->bits = (uint64_t*) malloc(BITMAP_BITSET_WORDS * sizeof(uint64_t));
+        assert(pContainer->bits != NULL);
+        memcpy(pContainer->bits, words, BITMAP_BITSET_WORDS * sizeof(uint64_t));
+    } else {
+        pContainer->values = (uint16_t*) malloc(cardinality * sizeof(uint16_t));
+        assert(pContainer->values != NULL);
+        pContainer->capacity = cardinality;
+        cardinality = 0;
+        for (i = 0; i < BITMAP_BITSET_WORDS; i++) {
+            for (word = words[i]; word != 0; word &= word - 1) {
+                pContainer->values[cardinality++] = (uint16_t)(i * 64 + __builtin_ctzll(word));
+            }
+        }
+    }
+}
+
+// Store on result the values on both bitmaps. Result must be initialized and is replaced
+void bitmap_and(const tBitmap* a, const tBitmap* b, tBitmap* result) {
+    tBitmap output;
+    uint64_t wordsA[BITMAP_BITSET_WORDS];
+    uint64_t wordsB[BITMAP_BITSET_WORDS];
+    int i;
+    int j;
+    int k;
+    
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(result != NULL);
+    
+    // Merge the sorted containers. Only keys on both bitmaps can have values
+    bitmap_init(&output);
+    i = 0;
+    j = 0;
+    while (i < a->count && j < b->count) {
+        if (a->containers[i].key < b->containers[j].key) {
+            i++;
+        } else if (a->containers[i].key > b->containers[j].key) {
+            j++;
+        } else {
+            bitmap_containerWords(&(a->containers[i]), wordsA);
+            bitmap_containerWords(&(b->containers[j]), wordsB);
+            for (k = 0; k < BITMAP_BITSET_WORDS; k++) {
+                wordsA[k] &= wordsB[k];
+            }
+            bitmap_appendWords(&output, a->containers[i].key, wordsA);
+            i++;
+            j++;
+        }
+    }
+    
+    // Result can be one of the inputs
+    bitmap_free(result);
+    *result = output;
+}
+
+// Store on result the values on any of the bitmaps. Result must be initialized and is replaced
+void bitmap_or(const tBitmap* a, const tBitmap* b, tBitmap* result) {
+    tBitmap output;
+    uint64_t wordsA[BITMAP_BITSET_WORDS];
+    uint64_t wordsB[BITMAP_BITSET_WORDS];
+    uint16_t key;
+    int i;
+    int j;
+    int k;
+    
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(result != NULL);
+    
+    // Merge the sorted containers, taking the missing ones as empty
+    bitmap_init(&output);
+    i = 0;
+    j = 0;
+    while (i < a->count || j < b->count) {
+        if (j == b->count || (i < a->count && a->containers[i].key < b->containers[j].key)) {
+            key = a->containers[i].key;
+            bitmap_containerWords(&(a->containers[i++]), wordsA);
+            bitmap_containerWords(NULL, wordsB);
+        } else if (i == a->count || a->containers[i].key > b->containers[j].key) {
+            key = b->containers[j].key;
+            bitmap_containerWords(NULL, wordsA);
+            bitmap_containerWords(&(b->containers[j++]), wordsB);
+        } else {
+            key = a->containers[i].key;
+            bitmap_containerWords(&(a->containers[i++]), wordsA);
+            bitmap_containerWords(&(b->containers[j++]), wordsB);
+        }
+        for (k = 0; k < BITMAP_BITSET_WORDS; k++) {
+            wordsA[k] |= wordsB[k];
+        }
+        bitmap_appendWords(&output, key, wordsA);
+    }
+    
+    // Result can be one of the inputs
+    bitmap_free(result);
+    *result = output;
+}
+
+// Store on result the values on a that are not on b. Result must be initialized and is replaced
+void bitmap_andNot(const tBitmap* a, const tBitmap* b, tBitmap* result) {
+    tBitmap output;
+    uint64_t wordsA[BITMAP_BITSET_WORDS];
+    uint64_t wordsB[BITMAP_BITSET_WORDS];
+    int i;
+    int j;
+    int k;
+    
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(result != NULL);
+    
+    // Keep the containers of a, removing the values of the container of b with the same key
+    bitmap_init(&output);
+    j = 0;
+    for (i = 0; i < a->count; i++) {
+        while (j < b->count && b->containers[j].key < a->containers[i].key) {
+            j++;
+        }
+        bitmap_containerWords(&(a->containers[i]), wordsA);
+        if (j < b->count && b->containers[j].key == a->containers[i].key) {
+            bitmap_containerWords(&(b->containers[j]), wordsB);
+            for (k = 0; k < BITMAP_BITSET_WORDS; k++) {
+                wordsA[k] &= ~wordsB[k];
+            }
+        }
+        bitmap_appendWords(&output, a->containers[i].key, wordsA);
+    }
+    
+    // Result can be one of the inputs
+    bitmap_free(result);
+    *result = output;
+}
+
+// Call the visitor for each value, in increasing order
+void bitmap_visit(const tBitmap* bitmap, tBitmapVisitor visitor, void* context) {
+    const tBitmapContainer *pContainer;
+    uint32_t high;
+    uint64_t word;
+    int i;
+    int j;
+    
+    assert(bitmap != NULL);
+    assert(visitor != NULL);
+    
+    for (i = 0; i < bitmap->count; i++) {
+        pContainer = &(bitmap->containers[i]);
+        high = (uint32_t)pContainer->key << 16;
+        if (pContainer->bits == NULL) {
+            for (j = 0; j < pContainer->cardinality; j++) {
+                visitor(high | pContainer->values[j], context);
+            }
+        } else {
+            for (j = 0; j < BITMAP_BITSET_WORDS; j++) {
+                for (word = pContainer->bits[j]; word != 0; word &= word - 1) {
+                    visitor(high | (uint32_t)(j * 64 + __builtin_ctzll(word)), context);
+                }
+            }
+        }
+    }
+}
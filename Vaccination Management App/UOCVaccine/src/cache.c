@@ -0,0 +1,92 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "cache.h"
+
+// Get the position of the entry for the given center, vaccine and day
+int availabilityCache_slot(tAvailabilityCache* cache, tHealthCenter* center, tVaccine* vaccine, tDate day) {
+    uint64_t hash;
+
+    // Mix the addresses and the packed date
+    hash = (uint64_t)(uintptr_t)center * 0x9E3779B97F4A7C15ULL;
+    hash ^= (uint64_t)(uintptr_t)vaccine * 0xC2B2AE3D27D4EB4FULL;
+    hash ^= (uint64_t)((day.year << 9) | (day.month << 5) | day.day) * 0x165667B19E3779F9ULL;
+    hash ^= hash >> 29;
+
+    return (int)(hash % (uint64_t)cache->size);
+}
+
+// Initialize the cache with the given number of entries
+void availabilityCache_init(tAvailabilityCache* cache, int size) {
+    assert(cache != NULL);
+    assert(size > 0);
+
+    cache->elems = (tAvailabilityCacheEntry*) malloc(size * sizeof(tAvailabilityCacheEntry));
+    assert(cache->elems != NULL);
+    cache->size = size;
+
+    availabilityCache_clear(cache);
+}
+
+// Release the cache data
+void availabilityCache_free(tAvailabilityCache* cache) {
+    assert(cache != NULL);
+
+    if (cache->elems != NULL) {
+        free(cache->elems);
+    }
+    cache->elems = NULL;
+    cache->size = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+// Remove all the cached answers
+void availabilityCache_clear(tAvailabilityCache* cache) {
+    int i;
+
+    assert(cache != NULL);
+
+    for (i = 0; i < cache->size; i++) {
+        cache->elems[i].center = NULL;
+    }
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+// Search a valid answer for the given center, vaccine and day. Return true if it was found
+bool availabilityCache_find(tAvailabilityCache* cache, tHealthCenter* center, tVaccine* vaccine, tDate day, bool* available) {
+    tAvailabilityCacheEntry *pEntry;
+
+    assert(cache != NULL);
+    assert(center != NULL);
+    assert(available != NULL);
+
+    pEntry = &(cache->elems[availabilityCache_slot(cache, center, vaccine, day)]);
+
+    // Answers computed with an older stock are never served
+    if (pEntry->center == center && pEntry->vaccine == vaccine && pEntry->epoch == center->stock.epoch && date_cmp(pEntry->day, day) == 0) {
+        *available = pEntry->available;
+        cache->hits++;
+        return true;
+    }
+
+    cache->misses++;
+    return false;
+}
+
+// Store the answer for the given center, vaccine and day
+void availabilityCache_store(tAvailabilityCache* cache, tHealthCenter* center, tVaccine* vaccine, tDate day, bool available) {
+    tAvailabilityCacheEntry *pEntry;
+
+    assert(cache != NULL);
+    assert(center != NULL);
+
+    // Replace the previous answer on this position
+    pEntry = &(cache->elems[availabilityCache_slot(cache, center, vaccine, day)]);
+    pEntry->center = center;
+    pEntry->vaccine = vaccine;
+    pEntry->day = day;
+    pEntry->epoch = center->stock.epoch;
+    pEntry->available = available;
+}
@@ -7,14 +7,23 @@
 void center_init(tHealthCenter* center, const char* cp) {
     // PR2 Ex 2a
     
+    // Allocate the cp with malloc
+    center_initArena(center, cp, NULL, NULL);
+}
+
+// Initialize a center storing the cp on the arena. If arena is NULL the cp is allocated with malloc. If cps is not NULL, the cp refers to the interned one
+void center_initArena(tHealthCenter* center, const char* cp, tStringArena* arena, tPostalCodeTable* cps) {
     assert(center != NULL);
-    
-    // Allocate the memory for the cp
-    center->cp = (char*) malloc(strlen(cp) + 1);
-    assert(center->cp != NULL);
-    
-    // Copy the cp
-    strcpy(center->cp, cp);    
+    assert(cp != NULL);
+    
+    // Copy the cp, or refer to the interned one
+    if (cps != NULL) {
+        center->cpId = postalCodeTable_intern(cps, cp);
+        center->cp = (char*) postalCodeTable_get(cps, center->cpId);
+    } else {
+        center->cpId = POSTAL_CODE_UNKNOWN;
+        center->cp = stringArena_strdup(arena, cp);
+    }
     
     // Initialize the stock
     stockList_init(&(center->stock));
@@ -24,7 +33,13 @@ void center_init(tHealthCenter* center, const char* cp) {
     /////////////////////////////////
     
     // Initialize appointments data
-    appointmentData_init(&(center->appointments));
+    doseSeriesData_init(&(center->series));
+    
+    // Initialize the waitlist
+    waitlist_init(&(center->waitlist));
+    
+    // Initialize the slots, without limit
+    slotCalendar_init(&(center->slots));
 }
 
 // Release a center's data
@@ -48,7 +63,13 @@ void center_free(tHealthCenter* center) {
     /////////////////////////////////
 
     // Remove appointments data
-    appointmentData_free(&(center->appointments));
+    doseSeriesData_free(&(center->series));
+    
+    // Remove the waitlist
+    waitlist_free(&(center->waitlist));
+    
+    // Remove the slots
+    slotCalendar_free(&(center->slots));
 }
 
 // Initialize a list of centers
@@ -59,6 +80,8 @@ void centerList_init(tHealthCenterList* list) {
     
     list->count = 0;
     list->first = NULL;
+    list->arena = NULL;
+    list->cps = NULL;
 }
 
 // Release a list of centers
@@ -72,6 +95,10 @@ void centerList_free(tHealthCenterList* list) {
     // Remove all elements in the list
     pNode = list->first;
     while(pNode != NULL) {
+        // Cps stored on the arena or interned are released with them
+        if (list->arena != NULL || list->cps != NULL) {
+            pNode->elem.cp = NULL;
+        }
         center_free(&(pNode->elem));
         pAux = pNode;
         pNode = pNode->next;
@@ -99,7 +126,7 @@ void centerList_insert(tHealthCenterList* list, const char* cp) {
             list->first = (tHealthCenterNode*) malloc(sizeof(tHealthCenterNode));
             assert(list->first != NULL);
             list->first->next = pAux;
-            center_init(&(list->first->elem), cp);
+            center_initArena(&(list->first->elem), cp, list->arena, list->cps);
         } else {        
             // Search insertion point
             pAux = list->first;
@@ -111,7 +138,7 @@ void centerList_insert(tHealthCenterList* list, const char* cp) {
             pAux->next = (tHealthCenterNode*) malloc(sizeof(tHealthCenterNode));
             assert(pAux->next != NULL);
             pAux->next->next = pNode;
-            center_init(&(pAux->next->elem), cp);
+            center_initArena(&(pAux->next->elem), cp, list->arena, list->cps);
         }
         // Increase the number of elements
         list->count++;
@@ -127,6 +154,11 @@ tHealthCenter* centerList_find(tHealthCenterList* list, const char* cp) {
     
     assert(list != NULL);
     
+    // With interned cps, compare the identifiers
+    if (list->cps != NULL) {
+        return centerList_findById(list, postalCodeTable_find(list->cps, cp));
+    }
+    
     // Search center with provided cp
     pNode = list->first;
     pCenter = NULL;
@@ -140,3 +172,23 @@ tHealthCenter* centerList_find(tHealthCenterList* list, const char* cp) {
     return pCenter;
 }
 
+
+// Find a center by the identifier of its interned cp
+tHealthCenter* centerList_findById(tHealthCenterList* list, int cpId) {
+    tHealthCenterNode *pNode;
+    
+    assert(list != NULL);
+    
+    // Codes that are not interned have no center
+    if (cpId == POSTAL_CODE_UNKNOWN) {
+        return NULL;
+    }
+    
+    // Compare the identifiers instead of the strings
+    pNode = list->first;
+    while(pNode != NULL && pNode->elem.cpId != cpId) {
+        pNode = pNode->next;
+    }
+    
+    return pNode == NULL ? NULL : &(pNode->elem);
+}
@@ -0,0 +1,310 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "columnar.h"
+
+// Create a column file with the given number of rows and columns. Return false if it cannot be created
+bool columnFile_open(tColumnFile* file, const char* filename, int rows, int columns) {
+    assert(file != NULL);
+    assert(filename != NULL);
+    assert(rows >= 0);
+    assert(columns > 0);
+    
+    file->file = fopen(filename, "wb");
+    if (file->file == NULL) {
+        return false;
+    }
+    
+    memset(&(file->header), 0, sizeof(tColumnFileHeader));
+    strcpy(file->header.magic, COLUMN_FILE_MAGIC);
+    file->header.version = COLUMN_FILE_VERSION;
+    file->header.rows = (uint32_t) rows;
+    file->header.columns = (uint32_t) columns;
+    file->columns = (tColumnDescriptor*) calloc(columns, sizeof(tColumnDescriptor));
+    assert(file->columns != NULL);
+    file->count = 0;
+    file->chunkCount = 0;
+    file->previous = 0;
+    file->error = false;
+    
+    // The descriptors are written again when all the columns are known
+    columnFile_write(file, &(file->header), sizeof(tColumnFileHeader));
+    columnFile_write(file, file->columns, columns * sizeof(tColumnDescriptor));
+    
+    return true;
+}
+
+// Start an integer column
+void columnFile_beginColumn(tColumnFile* file, const char* name, tColumnEncoding encoding) {
+    columnFile_startColumn(file, name, COLUMN_INT32, encoding);
+}
+
+// Start a dictionary column, writing its entries. The codes of the rows are added with columnFile_putValue
+void columnFile_beginDictionary(tColumnFile* file, const char* name, char* const* entries, int count) {
+    uint32_t entryCount;
+    int32_t offset;
+    int i;
+    
+    assert(entries != NULL || count == 0);
+    
+    columnFile_startColumn(file, name, COLUMN_DICTIONARY, COLUMN_PLAIN);
+    
+    // Number of entries and offset of each one
+    entryCount = (uint32_t) count;
+    columnFile_write(file, &entryCount, sizeof(uint32_t));
+    offset = 0;
+    for (i = 0; i < count; i++) {
+        columnFile_putValue(file, offset);
+        offset += (int32_t) strlen(entries[i]) + 1;
+    }
+    columnFile_flushChunk(file);
+    
+    // Entries, so they can be used without copying them
+    for (i = 0; i < count; i++) {
+        columnFile_write(file, entries[i], strlen(entries[i]) + 1);
+    }
+    columnFile_pad(file, 4);
+}
+
+// Add the value of the next row of the current column
+void columnFile_putValue(tColumnFile* file, int32_t value) {
+    assert(file != NULL);
+    assert(file->count > 0);
+    
+    if (file->chunkCount == COLUMN_CHUNK_VALUES) {
+        columnFile_flushChunk(file);
+    }
+    
+    // Differences are computed without sign, so they wrap around instead of overflowing
+    if (file->columns[file->count - 1].encoding == COLUMN_DELTA) {
+        file->chunk[file->chunkCount++] = (int32_t) ((uint32_t) value - (uint32_t) file->previous);
+        file->previous = value;
+    } else {
+        file->chunk[file->chunkCount++] = value;
+    }
+}
+
+// End the current column
+void columnFile_endColumn(tColumnFile* file) {
+    tColumnDescriptor *pColumn = NULL;
+    
+    assert(file != NULL);
+    assert(file->count > 0);
+    
+    columnFile_flushChunk(file);
+    pColumn = &(file->columns[file->count - 1]);
+    pColumn->size = (uint64_t) ftell(file->file) - pColumn->offset;
+}
+
+// Write the descriptors and close the file. Return false if some write failed
+bool columnFile_close(tColumnFile* file) {
+    bool ok;
+    
+    assert(file != NULL);
+    assert(file->file != NULL);
+    
+    // Only the started columns are stored
+    file->header.columns = (uint32_t) file->count;
+    if (fseek(file->file, 0, SEEK_SET) != 0) {
+        file->error = true;
+    }
+    columnFile_write(file, &(file->header), sizeof(tColumnFileHeader));
+    columnFile_write(file, file->columns, file->count * sizeof(tColumnDescriptor));
+    
+    ok = !file->error;
+    if (fclose(file->file) != 0) {
+        ok = false;
+    }
+    free(file->columns);
+    file->file = NULL;
+    file->columns = NULL;
+    file->count = 0;
+    
+    return ok;
+}
+
+// Load a column file in memory. Return false if it cannot be read or it is not a column file
+bool columnTable_load(tColumnTable* table, const char* filename) {
+    FILE *fin;
+    bool valid;
+    uint32_t i;
+    
+    assert(table != NULL);
+    assert(filename != NULL);
+    
+    table->data = NULL;
+    table->size = 0;
+    table->header = NULL;
+    table->columns = NULL;
+    
+    fin = fopen(filename, "rb");
+    if (fin == NULL) {
+        return false;
+    }
+    
+    // The whole file is read at once, the columns are used from the buffer
+    valid = fseek(fin, 0, SEEK_END) == 0;
+    if (valid) {
+        table->size = ftell(fin);
+        valid = table->size >= (long) sizeof(tColumnFileHeader) && fseek(fin, 0, SEEK_SET) == 0;
+    }
+    if (valid) {
+        table->data = (char*) malloc(table->size);
+        assert(table->data != NULL);
+        valid = fread(table->data, 1, table->size, fin) == (size_t) table->size;
+    }
+    fclose(fin);
+    
+    if (valid) {
+        table->header = (const tColumnFileHeader*) table->data;
+        table->columns = (const tColumnDescriptor*) (table->data + sizeof(tColumnFileHeader));
+        valid = memcmp(table->header->magic, COLUMN_FILE_MAGIC, sizeof(COLUMN_FILE_MAGIC)) == 0 &&
+                table->header->version == COLUMN_FILE_VERSION &&
+                sizeof(tColumnFileHeader) + table->header->columns * sizeof(tColumnDescriptor) <= (size_t) table->size;
+    }
+    
+    // Check that all the columns are inside the file
+    for (i = 0; valid && i < table->header->columns; i++) {
+        valid = table->columns[i].offset + table->columns[i].size <= (uint64_t) table->size &&
+                table->columns[i].size >= (uint64_t) table->header->rows * sizeof(int32_t) &&
+                table->columns[i].name[COLUMN_NAME_LENGTH - 1] == '\0';
+    }
+    
+    if (!valid) {
+        columnTable_free(table);
+    }
+    
+    return valid;
+}
+
+// Release a loaded column file
+void columnTable_free(tColumnTable* table) {
+    assert(table != NULL);
+    
+    if (table->data != NULL) {
+        free(table->data);
+    }
+    table->data = NULL;
+    table->size = 0;
+    table->header = NULL;
+    table->columns = NULL;
+}
+
+// Get the descriptor of a column. NULL if it does not exist
+const tColumnDescriptor* columnTable_find(const tColumnTable* table, const char* name) {
+    uint32_t i;
+    
+    assert(table != NULL);
+    assert(name != NULL);
+    
+    if (table->header == NULL) {
+        return NULL;
+    }
+    
+    for (i = 0; i < table->header->columns; i++) {
+        if (strcmp(table->columns[i].name, name) == 0) {
+            return &(table->columns[i]);
+        }
+    }
+    
+    return NULL;
+}
+
+// Get the values of a column, or the codes of a dictionary column. Delta encoded values are returned as stored
+const int32_t* columnTable_values(const tColumnTable* table, const tColumnDescriptor* column) {
+    assert(table != NULL);
+    assert(column != NULL);
+    
+    // Values are always at the end of the column
+    return (const int32_t*) (table->data + column->offset + column->size - table->header->rows * sizeof(int32_t));
+}
+
+// Copy the decoded values of an integer column
+void columnTable_decode(const tColumnTable* table, const tColumnDescriptor* column, int32_t* values) {
+    const int32_t *pValues;
+    uint32_t i;
+    
+    assert(values != NULL || table->header->rows == 0);
+    
+    pValues = columnTable_values(table, column);
+    memcpy(values, pValues, table->header->rows * sizeof(int32_t));
+    if (column->encoding == COLUMN_DELTA) {
+        for (i = 1; i < table->header->rows; i++) {
+            values[i] = (int32_t) ((uint32_t) values[i - 1] + (uint32_t) values[i]);
+        }
+    }
+}
+
+// Get the number of entries of a dictionary column
+int columnTable_dictionaryLen(const tColumnTable* table, const tColumnDescriptor* column) {
+    assert(table != NULL);
+    assert(column != NULL);
+    assert(column->type == COLUMN_DICTIONARY);
+    
+    return (int) *((const uint32_t*) (table->data + column->offset));
+}
+
+// Get an entry of a dictionary column
+const char* columnTable_dictionaryEntry(const tColumnTable* table, const tColumnDescriptor* column, int code) {
+    const uint32_t *pOffsets;
+    int count;
+    
+    count = columnTable_dictionaryLen(table, column);
+    assert(code >= 0 && code < count);
+    
+    // Entries start after the offsets
+    pOffsets = (const uint32_t*) (table->data + column->offset + sizeof(uint32_t));
+    return table->data + column->offset + sizeof(uint32_t) * (count + 1) + pOffsets[code];
+}
+
+// [AUX METHOD] Write bytes on the file
+void columnFile_write(tColumnFile* file, const void* bytes, size_t size) {
+    assert(file != NULL);
+    
+    if (size > 0 && fwrite(bytes, 1, size, file->file) != size) {
+        file->error = true;
+    }
+}
+
+// [AUX METHOD] Write the values of the chunk
+void columnFile_flushChunk(tColumnFile* file) {
+    assert(file != NULL);
+    
+    columnFile_write(file, file->chunk, file->chunkCount * sizeof(int32_t));
+    file->chunkCount = 0;
+}
+
+// [AUX METHOD] Add zeros up to a multiple of the given number of bytes from the start of the file
+void columnFile_pad(tColumnFile* file, int alignment) {
+    static const char zeros[8] = {0};
+    long position;
+    
+    assert(file != NULL);
+    assert(alignment > 0 && alignment <= 8);
+    
+    position = ftell(file->file);
+    if (position % alignment != 0) {
+        columnFile_write(file, zeros, alignment - position % alignment);
+    }
+}
+
+// [AUX METHOD] Start a column on the next multiple of 8 bytes
+void columnFile_startColumn(tColumnFile* file, const char* name, tColumnType type, tColumnEncoding encoding) {
+    tColumnDescriptor *pColumn = NULL;
+    
+    assert(file != NULL);
+    assert(name != NULL);
+    assert(strlen(name) < COLUMN_NAME_LENGTH);
+    assert(file->count < (int) file->header.columns);
+    assert(file->chunkCount == 0);
+    
+    columnFile_pad(file, 8);
+    pColumn = &(file->columns[file->count]);
+    strcpy(pColumn->name, name);
+    pColumn->type = type;
+    pColumn->encoding = encoding;
+    pColumn->offset = (uint64_t) ftell(file->file);
+    pColumn->size = 0;
+    file->count++;
+    file->previous = 0;
+}
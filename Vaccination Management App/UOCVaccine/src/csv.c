@@ -16,6 +16,7 @@ void csv_initEntry(tCSVEntry* entry) {
     entry->numFields = 0;    
     entry->fields = NULL;
     entry->type = NULL;
+    entry->typeId = CSV_UNKNOWN_TYPE;
 }
 
 // Add a new entry to the CSV Data
@@ -76,27 +77,52 @@ void csv_parse(tCSVData* data, const char* input, const char* type) {
 
 // Print the content of the CSV data structure
 void csv_print(tCSVData data) {
+    tReportWriter writer;
+    
+    writer_initFile(&writer, stdout, REPORT_CSV);
+    csv_write(data, &writer);
+    writer_free(&writer);
+}
+
+// Print the content of the CSV entry structure
+void csv_printEntry(tCSVEntry entry) {
+    tReportWriter writer;
+    
+    writer_initFile(&writer, stdout, REPORT_CSV);
+    csv_writeEntry(entry, &writer);
+    writer_free(&writer);
+}
+
+// Write the content of the CSV data structure with the format of csv_print
+void csv_write(tCSVData data, tReportWriter* writer) {
     int i;
     tCSVEntry* entry = NULL;
     
     for (i = 0; i < csv_numEntries(data); i++) {
         entry = csv_getEntry(data, i);
-        printf("===============\n");
-        printf("Entry %d: %s\n", i, entry->type);
-        printf("===============\n");
-        csv_printEntry(*entry);
-        printf("===============\n");
+        writer_putStr(writer, "===============\nEntry ");
+        writer_putInt(writer, i);
+        writer_putStr(writer, ": ");
+        writer_putStr(writer, entry->type);
+        writer_putStr(writer, "\n===============\n");
+        csv_writeEntry(*entry, writer);
+        writer_putStr(writer, "===============\n");
     }    
 }
 
-// Print the content of the CSV entry structure
-void csv_printEntry(tCSVEntry entry) {
+// Write the content of the CSV entry structure with the format of csv_printEntry
+void csv_writeEntry(tCSVEntry entry, tReportWriter* writer) {
     int i;
-    char buffer[512];    
-    printf("\tNum Fields: %d\n", csv_numFields(entry));
+    
+    writer_putStr(writer, "\tNum Fields: ");
+    writer_putInt(writer, csv_numFields(entry));
+    writer_putChar(writer, '\n');
     for (i = 0; i < csv_numFields(entry); i++) {
-        csv_getAsString(entry, i, buffer, 512);
-        printf("\tField %d: %s\n", i, buffer);
+        writer_putStr(writer, "\tField ");
+        writer_putInt(writer, i);
+        writer_putStr(writer, ": ");
+        writer_putStr(writer, entry.fields[i]);
+        writer_putChar(writer, '\n');
     }
 }
 
@@ -111,10 +137,7 @@ void csv_parseEntry(tCSVEntry* entry, const char* input, const char* type) {
     
     // If the type of the entry is not provided, use the first field
     if(type != NULL) {
-        len = strlen(type) + 1;
-        entry->type = (char*) malloc(len * sizeof(char));
-        memset(entry->type, 0, len * sizeof(char));
-        strncpy(entry->type, type, len);
+        csv_setType(entry, type, strlen(type));
         readType = false;
     }        
     pStart = input;
@@ -124,9 +147,7 @@ void csv_parseEntry(tCSVEntry* entry, const char* input, const char* type) {
         len = pEnd - pStart + 1;
         
         if(readType) {
-            entry->type = (char*) malloc(len * sizeof(char));
-            memset(entry->type, 0, len * sizeof(char));
-            strncpy(entry->type, pStart, pEnd - pStart);
+            csv_setType(entry, pStart, pEnd - pStart);
             readType = false;
         } else {
             entry->numFields++;
@@ -161,6 +182,36 @@ void csv_parseEntry(tCSVEntry* entry, const char* input, const char* type) {
     }
 }
 
+// Split a CSV line in place, replacing separators by '\0'. Store up to maxFields pointers to the fields and return the number of fields
+int csv_splitLine(char* line, char** fields, int maxFields) {
+    char *pStart, *pEnd;
+    int numFields = 0;
+    
+    assert(line != NULL);
+    assert(fields != NULL);
+    
+    // Same rules as csv_parseEntry: an empty field ends the split and the rest of the line is the last field
+    pStart = line;
+    pEnd = strchr(pStart, ';');
+    while (pEnd != NULL && pEnd != pStart) {
+        *pEnd = '\0';
+        if (numFields < maxFields) {
+            fields[numFields] = pStart;
+        }
+        numFields++;
+        pStart = pEnd + 1;
+        pEnd = strchr(pStart, ';');
+    }
+    if (*pStart != '\0') {
+        if (numFields < maxFields) {
+            fields[numFields] = pStart;
+        }
+        numFields++;
+    }
+    
+    return numFields;
+}
+
 // Get the number of entries
 bool csv_isValid(tCSVData data) {
     return data.isValid;
@@ -189,7 +240,8 @@ void csv_freeEntry(tCSVEntry* entry) {
         
         free(entry->fields);
     }
-    if(entry->type != NULL) {
+    // Names of known types are shared
+    if(entry->type != NULL && entry->typeId == CSV_UNKNOWN_TYPE) {
         free(entry->type);
     }
     csv_initEntry(entry);
@@ -205,6 +257,65 @@ const char* csv_getType(tCSVEntry* entry) {
     return (const char*)entry->type;
 }
 
+// Get the id of the type of the entry. CSV_UNKNOWN_TYPE if the type is not known
+int csv_getTypeId(tCSVEntry* entry) {
+    assert(entry != NULL);
+    
+    return entry->typeId;
+}
+
+// Get the id of a known type. CSV_UNKNOWN_TYPE if it is not known
+int csv_findType(const char* type) {
+    assert(type != NULL);
+    
+    return csv_findTypeLength(type, strlen(type));
+}
+
+// Get the name of a known type
+const char* csv_typeName(int typeId) {
+    assert(typeId >= 0 && typeId < CSV_NUM_TYPES);
+    
+    if (typeId == CSV_TYPE_PERSON) {
+        return "PERSON";
+    }
+    
+    return "VACCINE_LOT";
+}
+
+// [AUX METHOD] Get the id of a known type given by its first length characters
+int csv_findTypeLength(const char* type, int length) {
+    const char* name;
+    int i;
+    
+    assert(type != NULL);
+    
+    for (i = 0; i < CSV_NUM_TYPES; i++) {
+        name = csv_typeName(i);
+        if (name[0] == type[0] && strncmp(name, type, length) == 0 && name[length] == '\0') {
+            return i;
+        }
+    }
+    
+    return CSV_UNKNOWN_TYPE;
+}
+
+// [AUX METHOD] Set the type of an entry given by its first length characters
+void csv_setType(tCSVEntry* entry, const char* type, int length) {
+    assert(entry != NULL);
+    assert(type != NULL);
+    
+    // Known types are shared, other types are copied
+    entry->typeId = csv_findTypeLength(type, length);
+    if (entry->typeId != CSV_UNKNOWN_TYPE) {
+        entry->type = (char*) csv_typeName(entry->typeId);
+    } else {
+        entry->type = (char*) malloc((length + 1) * sizeof(char));
+        assert(entry->type != NULL);
+        memcpy(entry->type, type, length);
+        entry->type[length] = '\0';
+    }
+}
+
 // Get an entry from the CSV data
 tCSVEntry* csv_getEntry(tCSVData data, int position) {
     return &(data.entries[position]);
@@ -217,7 +328,12 @@ int csv_numFields(tCSVEntry entry) {
 
 // Get a field from the given entry as integer
 int csv_getAsInteger(tCSVEntry entry, int position) {
-    return atoi(entry.fields[position]);
+    int value;
+    
+    // As atoi, use the leading digits of malformed values
+    csv_parseInteger(entry.fields[position], &value);
+    
+    return value;
 }
 
 // Get a field from the given entry as string
@@ -228,7 +344,124 @@ void csv_getAsString(tCSVEntry entry, int position, char* buffer, int length) {
 
 // Get a field from the given entry as integer
 float csv_getAsReal(tCSVEntry entry, int position) {
-    return atof(entry.fields[position]);
+    float value;
+    
+    // As atof, use the leading part of malformed values
+    csv_parseReal(entry.fields[position], &value);
+    
+    return value;
+}
+
+// Parse a decimal integer. Return false if the text is not a valid integer
+bool csv_parseInteger(const char* str, int* value) {
+    long long result = 0;
+    bool negative = false;
+    bool valid;
+    const char *pChar;
+    
+    assert(str != NULL);
+    assert(value != NULL);
+    
+    // Skip leading blanks and get the sign
+    pChar = str;
+    while (*pChar == ' ' || *pChar == '\t') {
+        pChar++;
+    }
+    if (*pChar == '-' || *pChar == '+') {
+        negative = (*pChar == '-');
+        pChar++;
+    }
+    
+    // Accumulate the digits, saturating on overflow
+    valid = (*pChar >= '0' && *pChar <= '9');
+    while (*pChar >= '0' && *pChar <= '9') {
+        if (result <= 2147483648LL) {
+            result = result * 10 + (*pChar - '0');
+        }
+        pChar++;
+    }
+    if (negative) {
+        result = -result;
+    }
+    if (result > 2147483647LL) {
+        result = 2147483647LL;
+        valid = false;
+    } else if (result < -2147483648LL) {
+        result = -2147483648LL;
+        valid = false;
+    }
+    
+    *value = (int)result;
+    
+    // Nothing can follow the digits
+    return valid && *pChar == '\0';
+}
+
+// Parse a decimal real number using '.' as decimal separator. Return false if the text is not a valid number
+bool csv_parseReal(const char* str, float* value) {
+    double result = 0.0;
+    double scale = 1.0;
+    bool negative = false;
+    bool valid = false;
+    int exponent = 0;
+    bool negativeExponent = false;
+    const char *pChar;
+    
+    assert(str != NULL);
+    assert(value != NULL);
+    
+    // Skip leading blanks and get the sign
+    pChar = str;
+    while (*pChar == ' ' || *pChar == '\t') {
+        pChar++;
+    }
+    if (*pChar == '-' || *pChar == '+') {
+        negative = (*pChar == '-');
+        pChar++;
+    }
+    
+    // Integer part
+    while (*pChar >= '0' && *pChar <= '9') {
+        result = result * 10.0 + (*pChar - '0');
+        valid = true;
+        pChar++;
+    }
+    
+    // Decimal part
+    if (*pChar == '.') {
+        pChar++;
+        while (*pChar >= '0' && *pChar <= '9') {
+            scale /= 10.0;
+            result += (*pChar - '0') * scale;
+            valid = true;
+            pChar++;
+        }
+    }
+    
+    // Exponent
+    if (valid && (*pChar == 'e' || *pChar == 'E')) {
+        pChar++;
+        if (*pChar == '-' || *pChar == '+') {
+            negativeExponent = (*pChar == '-');
+            pChar++;
+        }
+        valid = (*pChar >= '0' && *pChar <= '9');
+        while (*pChar >= '0' && *pChar <= '9') {
+            if (exponent < 1000) {
+                exponent = exponent * 10 + (*pChar - '0');
+            }
+            pChar++;
+        }
+        while (exponent > 0) {
+            result = negativeExponent ? result / 10.0 : result * 10.0;
+            exponent--;
+        }
+    }
+    
+    *value = (float)(negative ? -result : result);
+    
+    // Nothing can follow the number
+    return valid && *pChar == '\0';
 }
 
 // Compare if two entries are the same
@@ -237,7 +470,7 @@ bool csv_equalsEntry(tCSVEntry entry1, tCSVEntry entry2) {
     if (entry1.numFields != entry2.numFields) {
         return false;
     }
-    if (strcmp(entry1.type, entry2.type) != 0) {
+    if (entry1.type != entry2.type && strcmp(entry1.type, entry2.type) != 0) {
         return false;
     }
     for (i = 0; i < entry1.numFields ; i++) {
@@ -0,0 +1,197 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cursor.h"
+
+// Open a cursor over a vaccine list
+void vaccineCursor_open(tVaccineCursor* cursor, tVaccineList* list) {
+    assert(cursor != NULL);
+    assert(list != NULL);
+    
+    cursor->list = list;
+    cursor->last = NULL;
+}
+
+// Copy the next vaccines to the array, up to n. Names refer to the list. Return the number of copied vaccines, 0 at the end
+int vaccineCursor_next(tVaccineCursor* cursor, tVaccine* vaccines, int n) {
+    tVaccineNode *pNode = NULL;
+    int count = 0;
+    
+    assert(cursor != NULL);
+    assert(vaccines != NULL || n == 0);
+    
+    if (cursor->list == NULL) {
+        return 0;
+    }
+    
+    // The list is sorted by name, so the batch starts after the last returned name even if it was removed
+    pNode = cursor->list->first;
+    while (pNode != NULL && cursor->last != NULL && strcmp(pNode->vaccine.name, cursor->last) <= 0) {
+        pNode = pNode->next;
+    }
+    
+    while (pNode != NULL && count < n) {
+        vaccines[count] = pNode->vaccine;
+        count++;
+        pNode = pNode->next;
+    }
+    
+    // Keep a copy of the last name, as the vaccine could be removed before the next batch
+    if (count > 0) {
+        if (cursor->last != NULL) {
+            free(cursor->last);
+        }
+        cursor->last = (char*) malloc(strlen(vaccines[count - 1].name) + 1);
+        assert(cursor->last != NULL);
+        strcpy(cursor->last, vaccines[count - 1].name);
+    }
+    
+    return count;
+}
+
+// Close the cursor and release its data
+void vaccineCursor_close(tVaccineCursor* cursor) {
+    assert(cursor != NULL);
+    
+    if (cursor->last != NULL) {
+        free(cursor->last);
+    }
+    cursor->last = NULL;
+    cursor->list = NULL;
+}
+
+// Open a cursor over a lots table
+void lotCursor_open(tLotCursor* cursor, tVaccineLotData* data) {
+    assert(cursor != NULL);
+    assert(data != NULL);
+    
+    cursor->data = data;
+    cursor->pos = 0;
+    cursor->end = data->count;
+}
+
+// Copy the next lots to the array, up to n. Cps and vaccines refer to the table. Return the number of copied lots, 0 at the end
+int lotCursor_next(tLotCursor* cursor, tVaccineLot* lots, int n) {
+    int count = 0;
+    
+    assert(cursor != NULL);
+    assert(lots != NULL || n == 0);
+    
+    if (cursor->data == NULL) {
+        return 0;
+    }
+    
+    // New lots are added at the end of the table. Removed lots reduce its size
+    while (count < n && cursor->pos < cursor->end && cursor->pos < cursor->data->count) {
+        lots[count] = cursor->data->elems[cursor->pos];
+        count++;
+        cursor->pos++;
+    }
+    
+    return count;
+}
+
+// Close the cursor
+void lotCursor_close(tLotCursor* cursor) {
+    assert(cursor != NULL);
+    
+    cursor->data = NULL;
+    cursor->pos = 0;
+    cursor->end = 0;
+}
+
+// Open a cursor over a population
+void populationCursor_open(tPopulationCursor* cursor, tPopulation* data) {
+    assert(cursor != NULL);
+    assert(data != NULL);
+    
+    cursor->data = data;
+    cursor->pos = 0;
+    cursor->end = data->count;
+}
+
+// Copy the next persons to the array, up to n. Text fields refer to the population. Return the number of copied persons, 0 at the end
+int populationCursor_next(tPopulationCursor* cursor, tPerson* persons, int n) {
+    int count = 0;
+    
+    assert(cursor != NULL);
+    assert(persons != NULL || n == 0);
+    
+    if (cursor->data == NULL) {
+        return 0;
+    }
+    
+    // New persons are added at the end of the population. Removed persons reduce its size
+    while (count < n && cursor->pos < cursor->end && cursor->pos < cursor->data->count) {
+        persons[count] = cursor->data->elems[cursor->pos];
+        count++;
+        cursor->pos++;
+    }
+    
+    return count;
+}
+
+// Close the cursor
+void populationCursor_close(tPopulationCursor* cursor) {
+    assert(cursor != NULL);
+    
+    cursor->data = NULL;
+    cursor->pos = 0;
+    cursor->end = 0;
+}
+
+// Open a cursor over the series of a list on the range [first, end), with the persons of the population. If list is NULL the cursor is empty
+void appointmentCursor_open(tAppointmentCursor* cursor, tDoseSeriesData* list, tPopulation* population, int first, int end) {
+    assert(cursor != NULL);
+    assert(population != NULL || list == NULL);
+    assert(first >= 0);
+    
+    cursor->list = list;
+    cursor->population = population;
+    cursor->series = first;
+    cursor->dose = 0;
+    cursor->end = end;
+}
+
+// Store on the array the next appointments, up to n. Persons refer to the population. Return the number of stored appointments, 0 at the end
+int appointmentCursor_next(tAppointmentCursor* cursor, tAppointment* appointments, int n) {
+    tDoseSeries *pSeries = NULL;
+    int count = 0;
+    
+    assert(cursor != NULL);
+    assert(appointments != NULL || n == 0);
+    
+    if (cursor->list == NULL) {
+        return 0;
+    }
+    
+    // New series are added at the end of the list
+    while (count < n && cursor->series < cursor->end && cursor->series < cursor->list->count) {
+        pSeries = &(cursor->list->elems[cursor->series]);
+        if (cursor->dose < pSeries->doses) {
+            appointments[count].timestamp = doseSeries_getDose(*pSeries, cursor->dose);
+            appointments[count].key = dateTime_toKey(appointments[count].timestamp);
+            // The population can be moved when it grows, so the person is taken on each batch
+            appointments[count].person = &(cursor->population->elems[pSeries->person]);
+            appointments[count].vaccine = pSeries->vaccine;
+            count++;
+            cursor->dose++;
+        } else {
+            cursor->series++;
+            cursor->dose = 0;
+        }
+    }
+    
+    return count;
+}
+
+// Close the cursor
+void appointmentCursor_close(tAppointmentCursor* cursor) {
+    assert(cursor != NULL);
+    
+    cursor->list = NULL;
+    cursor->population = NULL;
+    cursor->series = 0;
+    cursor->dose = 0;
+    cursor->end = 0;
+}
@@ -1,55 +1,39 @@
 #include <stdlib.h>
-#include <stdio.h>
 #include <assert.h>
 #include <string.h>
 #include "date.h"
 
-// Parse a tDateTime from string information
-void dateTime_parse(tDateTime* dateTime, const char* date, const char* time) {
+// Parse a tDateTime from "DD/MM/YYYY" and "HH:MM" strings. Return false if any of them is malformed
+bool dateTime_parse(tDateTime* dateTime, const char* date, const char* time) {
+    tDateTime value;
+    
     // Check output data
     assert(dateTime != NULL);
     
-    // Check input date
+    // Check input data
     assert(date != NULL);
-    assert(strlen(date) == 10);
-    
-    // Check input time
     assert(time != NULL);
-    assert(strlen(time) == 5);
     
-    // Parse the input date
-    sscanf(date, "%d/%d/%d", &(dateTime->date.day), &(dateTime->date.month), &(dateTime->date.year));
+    // Parse the input date and time
+    if (!date_parse(&(value.date), date) || !time_parse(&(value.time), time)) {
+        return false;
+    }
+    
+    *dateTime = value;
     
-    // Parse the input time
-    sscanf(time, "%d:%d", &(dateTime->time.hour), &(dateTime->time.minutes));
+    return true;
 }
 
 // Compare two tDateTime structures and return -1 if dateTime1<dateTime2, 0 if equals and 1 if dateTime1>dateTime2.
 int dateTime_cmp(tDateTime dateTime1, tDateTime dateTime2) {    
-    int date_res;
+    long long key1;
+    long long key2;
     
-    date_res = date_cmp(dateTime1.date, dateTime2.date);
+    // Pack all the fields in a single integer with the date on the most significant part
+    key1 = ((long long)dateTime1.date.year * 512 + dateTime1.date.month * 32 + dateTime1.date.day) * 2048 + dateTime1.time.hour * 64 + dateTime1.time.minutes;
+    key2 = ((long long)dateTime2.date.year * 512 + dateTime2.date.month * 32 + dateTime2.date.day) * 2048 + dateTime2.time.hour * 64 + dateTime2.time.minutes;
     
-    if (date_res != 0) {
-        return date_res;
-    }
-        
-    // Check hour
-    if (dateTime1.time.hour < dateTime2.time.hour) {
-        return -1;
-    }
-    if (dateTime1.time.hour > dateTime2.time.hour) {
-        return 1;
-    }
-    // Check minutes
-    if (dateTime1.time.minutes < dateTime2.time.minutes) {
-        return -1;
-    }
-    if (dateTime1.time.minutes > dateTime2.time.minutes) {
-        return 1;
-    }
-    
-    return 0;
+    return (key1 > key2) - (key1 < key2);
 }
 
 // Compare two tDateTime structures and return true if they contain the same value or false otherwise.
@@ -85,68 +69,180 @@ void dateTime_fromTime(tDateTime *timestamp, struct tm std_time) {
 
 // Add a days to a given date
 void dateTime_addDay(tDateTime* dateTime, int days) {
-    
-    struct tm initTimestamp = { 0 };   
-    
     assert(dateTime != NULL);
     
-    // Get standard time representation
-    dateTime_initTime(&initTimestamp, *dateTime);
+    // Time of the day is not modified
+    date_addDay(&(dateTime->date), days);
+}
+
+// Get the packed key of a tDateTime. Dates must not be before 01/01/1900
+tDateTimeKey dateTime_toKey(tDateTime dateTime) {
+    int days;
     
-    // Add the number of days
-    initTimestamp.tm_mday += days;
+    days = date_toDays(dateTime.date) - DATETIME_KEY_EPOCH_DAYS;
+    assert(days >= 0);
     
-    // Upate the date
-    mktime(&initTimestamp);
-    
-    // Update output structure
-    dateTime_fromTime(dateTime, initTimestamp);
+    return (tDateTimeKey)days * 1440 + dateTime.time.hour * 60 + dateTime.time.minutes;
 }
 
-// Parse a tDate from string information
-void date_parse(tDate* date, const char* str) {
-    // Parse the input date
-    sscanf(str, "%d/%d/%d", &(date->day), &(date->month), &(date->year));
+// Initialize a tDateTime from its packed key
+void dateTime_fromKey(tDateTime* dateTime, tDateTimeKey key) {
+    assert(dateTime != NULL);
+    
+    date_fromDays(&(dateTime->date), (int)(key / 1440) + DATETIME_KEY_EPOCH_DAYS);
+    dateTime->time.hour = (key % 1440) / 60;
+    dateTime->time.minutes = key % 60;
 }
 
-// Compare two tDate structures and return -1 if date1<date2, 0 if equals and 1 if date1>date2.
-int date_cmp(tDate date1, tDate date2) {
-    // Check year
-    if (date1.year < date2.year) {
-        return -1;
+// Parse a tDate from a "DD/MM/YYYY" string. Return false if it is malformed or the year is before DATE_MIN_YEAR
+bool date_parse(tDate* date, const char* str) {
+    int day;
+    int month;
+    int year;
+    
+    assert(date != NULL);
+    assert(str != NULL);
+    
+    // Check the separators and the length, so digits are in fixed positions
+    if (str[0] == '\0' || str[1] == '\0' || str[2] != '/' || str[3] == '\0' || str[4] == '\0' || str[5] != '/' || strlen(str + 6) != 4) {
+        return false;
+    }
+    
+    // Get the fields
+    day = date_parseDigits(str, 2);
+    month = date_parseDigits(str + 3, 2);
+    year = date_parseDigits(str + 6, 4);
+    
+    // Check the values. Older dates can not be packed on a tDateTime key
+    if (day < 1 || month < 1 || month > 12 || year < DATE_MIN_YEAR || day > date_daysInMonth(month, year)) {
+        return false;
     }
-    if (date1.year > date2.year) {
-        return 1;
+    
+    date->day = day;
+    date->month = month;
+    date->year = year;
+    
+    return true;
+}
+
+// Parse a tTime from a "HH:MM" string. Return false if it is malformed
+bool time_parse(tTime* time, const char* str) {
+    int hour;
+    int minutes;
+    
+    assert(time != NULL);
+    assert(str != NULL);
+    
+    // Check the separator and the length
+    if (str[0] == '\0' || str[1] == '\0' || str[2] != ':' || strlen(str + 3) != 2) {
+        return false;
     }
-    // Check month
-    if (date1.month < date2.month) {
-        return -1;
+    
+    // Get the fields
+    hour = date_parseDigits(str, 2);
+    minutes = date_parseDigits(str + 3, 2);
+    
+    // Check the values
+    if (hour < 0 || hour > 23 || minutes < 0 || minutes > 59) {
+        return false;
     }
-    if (date1.month > date2.month) {
-        return 1;
-    }  
-    // Check day
-    if (date1.day < date2.day) {
-        return -1;
+    
+    time->hour = hour;
+    time->minutes = minutes;
+    
+    return true;
+}
+
+// Get the number of days of a month
+int date_daysInMonth(int month, int year) {
+    const int days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    
+    assert(month >= 1 && month <= 12);
+    
+    if (month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+        return 29;
     }
-    if (date1.day > date2.day) {
-        return 1;
+    
+    return days[month - 1];
+}
+
+// [AUX METHOD] Get the value of a fixed number of digits. Return -1 if any of the characters is not a digit
+int date_parseDigits(const char* str, int length) {
+    int value = 0;
+    int i;
+    
+    for (i = 0; i < length; i++) {
+        if (str[i] < '0' || str[i] > '9') {
+            return -1;
+        }
+        value = value * 10 + (str[i] - '0');
     }
     
-    return 0;
+    return value;
+}
+
+// Compare two tDate structures and return -1 if date1<date2, 0 if equals and 1 if date1>date2.
+int date_cmp(tDate date1, tDate date2) {
+    int key1;
+    int key2;
+    
+    // Pack year, month and day in a single integer
+    key1 = date1.year * 512 + date1.month * 32 + date1.day;
+    key2 = date2.year * 512 + date2.month * 32 + date2.day;
+    
+    return (key1 > key2) - (key1 < key2);
 }
 
 // Add days to a given date
 void date_addDay(tDate* date, int days) {
-    tDateTime timestamp;
-    
     assert(date != NULL);
+    
+    date_fromDays(date, date_toDays(*date) + days);
+}
+
+// Get the day number of a given date, counted in days from 01/01/1970
+int date_toDays(tDate date) {
+    int year;
+    int era;
+    int yearOfEra;
+    int dayOfYear;
+    int dayOfEra;
+    
+    // Years start on March, so the leap day is the last day of the year
+    year = date.year - (date.month <= 2 ? 1 : 0);
+    era = (year >= 0 ? year : year - 399) / 400;
+    yearOfEra = year - era * 400;
+    dayOfYear = (153 * (date.month + (date.month > 2 ? -3 : 9)) + 2) / 5 + date.day - 1;
+    dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    
+    // 719468 is the day number of 01/01/1970 counted from 01/03/0000
+    return era * 146097 + dayOfEra - 719468;
+}
 
-    timestamp.date = *date;
-    timestamp.time.hour = 0;
-    timestamp.time.minutes = 0;
+// Initialize a date from its day number, counted in days from 01/01/1970
+void date_fromDays(tDate* date, int days) {
+    int era;
+    int dayOfEra;
+    int yearOfEra;
+    int dayOfYear;
+    int monthIndex;
     
-    dateTime_addDay(&timestamp, days);
+    assert(date != NULL);
     
-    *date = timestamp.date;
+    // Count days from 01/03/0000
+    days += 719468;
+    era = (days >= 0 ? days : days - 146096) / 146097;
+    dayOfEra = days - era * 146097;
+    yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    monthIndex = (5 * dayOfYear + 2) / 153;
+    
+    date->day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    date->month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    date->year = yearOfEra + era * 400 + (date->month <= 2 ? 1 : 0);
+}
+
+// Get the number of days from date1 to date2
+int date_diffDays(tDate date1, tDate date2) {
+    return date_toDays(date2) - date_toDays(date1);
 }
@@ -0,0 +1,96 @@
+#include <assert.h>
+#include <string.h>
+#include "document.h"
+
+// Get the packed key of a DNI (8 digits and letter) or NIE (X, Y or Z, 7 digits and letter). DOCUMENT_KEY_NONE for other documents
+tDocumentKey document_toKey(const char* document) {
+    uint64_t kind;
+    uint64_t number;
+    int i;
+    
+    assert(document != NULL);
+    
+    // Kind 1 is a DNI, and 2 to 4 a NIE starting with X, Y or Z. It keeps the order of the strings
+    if (document[0] >= '0' && document[0] <= '9') {
+        kind = 1;
+        number = document[0] - '0';
+    } else if (document[0] >= 'X' && document[0] <= 'Z') {
+        kind = 2 + (document[0] - 'X');
+        number = 0;
+    } else {
+        return DOCUMENT_KEY_NONE;
+    }
+    
+    // Seven more digits and an upper case letter
+    for (i = 1; i < 8; i++) {
+        if (document[i] < '0' || document[i] > '9') {
+            return DOCUMENT_KEY_NONE;
+        }
+        number = number * 10 + (document[i] - '0');
+    }
+    if (document[8] < 'A' || document[8] > 'Z' || document[9] != '\0') {
+        return DOCUMENT_KEY_NONE;
+    }
+    
+    return (kind << 40) | (number << 8) | (uint64_t)document[8];
+}
+
+// Check if the letter of a DNI or NIE matches its number
+bool document_isValid(const char* document) {
+    tDocumentKey key;
+    uint64_t kind;
+    uint64_t number;
+    
+    key = document_toKey(document);
+    if (key == DOCUMENT_KEY_NONE) {
+        return false;
+    }
+    
+    // The NIE letter counts as a leading digit: X is 0, Y is 1 and Z is 2
+    kind = key >> 40;
+    number = (key >> 8) & 0xFFFFFFFFULL;
+    if (kind > 1) {
+        number += (kind - 2) * 10000000ULL;
+    }
+    
+    return DOCUMENT_CHECK_LETTERS[number % 23] == (char)(key & 0xFF);
+}
+
+// Check if two documents are equal, comparing their keys when they are packed
+bool document_equals(tDocumentKey keyA, const char* documentA, tDocumentKey keyB, const char* documentB) {
+    // Packed keys and strings are never equal
+    if (keyA != DOCUMENT_KEY_NONE || keyB != DOCUMENT_KEY_NONE) {
+        return keyA == keyB;
+    }
+    
+    return strcmp(documentA, documentB) == 0;
+}
+
+// Compare two documents with the same order than strcmp, comparing their keys when they are packed
+int document_cmp(tDocumentKey keyA, const char* documentA, tDocumentKey keyB, const char* documentB) {
+    if (keyA != DOCUMENT_KEY_NONE && keyB != DOCUMENT_KEY_NONE) {
+        return keyA < keyB ? -1 : (keyA > keyB ? 1 : 0);
+    }
+    
+    return strcmp(documentA, documentB);
+}
+
+// Get a hash value of a document
+uint32_t document_hash(tDocumentKey key, const char* document) {
+    uint32_t hash;
+    const char *pChar;
+    
+    // Mix the bits of the packed key
+    if (key != DOCUMENT_KEY_NONE) {
+        key *= 0x9E3779B97F4A7C15ULL;
+        return (uint32_t)(key >> 32);
+    }
+    
+    // FNV-1a hash of the string
+    hash = 2166136261u;
+    for (pChar = document; *pChar != '\0'; pChar++) {
+        hash = (hash ^ (uint8_t)(*pChar)) * 16777619u;
+    }
+    
+    return hash;
+}
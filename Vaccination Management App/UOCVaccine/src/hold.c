@@ -0,0 +1,182 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "hold.h"
+
+// Initialize an empty wheel
+void holdWheel_init(tHoldWheel* wheel) {
+    int level;
+    int slot;
+    
+    assert(wheel != NULL);
+    
+    wheel->elems = NULL;
+    wheel->count = 0;
+    wheel->capacity = 0;
+    wheel->active = 0;
+    wheel->current = 0;
+    for (level = 0; level < HOLD_WHEEL_LEVELS; level++) {
+        for (slot = 0; slot < HOLD_WHEEL_SLOTS; slot++) {
+            wheel->slots[level][slot] = -1;
+        }
+    }
+}
+
+// Release the wheel data
+void holdWheel_free(tHoldWheel* wheel) {
+    assert(wheel != NULL);
+    
+    if (wheel->elems != NULL) {
+        free(wheel->elems);
+    }
+    holdWheel_init(wheel);
+}
+
+// Add a hold expiring at the given timestamp, before HOLD_WHEEL_SLOTS^HOLD_WHEEL_LEVELS minutes from the last processed one. Return its identifier
+int holdWheel_add(tHoldWheel* wheel, tHealthCenter* center, tDoseSeries series, tDateTime expiry) {
+    tHold* pHold;
+    
+    assert(wheel != NULL);
+    assert(center != NULL);
+    
+    // Double the allocated holds when it is full
+    if (wheel->count == wheel->capacity) {
+        wheel->capacity = wheel->capacity == 0 ? 16 : wheel->capacity * 2;
+        wheel->elems = (tHold*) realloc(wheel->elems, wheel->capacity * sizeof(tHold));
+        assert(wheel->elems != NULL);
+    }
+    
+    pHold = &(wheel->elems[wheel->count]);
+    pHold->center = center;
+    pHold->series = series;
+    pHold->expiry = dateTime_toKey(expiry);
+    pHold->active = true;
+    
+    // Holds already expired are processed on the next minute
+    if (pHold->expiry <= wheel->current) {
+        pHold->expiry = wheel->current + 1;
+    }
+    assert(pHold->expiry - wheel->current < (1u << (HOLD_WHEEL_BITS * HOLD_WHEEL_LEVELS)));
+    pHold->next = -1;
+    wheel->count++;
+    wheel->active++;
+    
+    holdWheel_insert(wheel, wheel->count - 1);
+    
+    return wheel->count - 1;
+}
+
+// Get an active hold. NULL if it does not exist or it is not active
+tHold* holdWheel_get(tHoldWheel* wheel, int id) {
+    assert(wheel != NULL);
+    
+    if (id < 0 || id >= wheel->count || !wheel->elems[id].active) {
+        return NULL;
+    }
+    
+    return &(wheel->elems[id]);
+}
+
+// Mark a hold as not active
+void holdWheel_remove(tHoldWheel* wheel, int id) {
+    assert(wheel != NULL);
+    
+    // The hold stays on its slot until the slot is processed
+    if (holdWheel_get(wheel, id) != NULL) {
+        wheel->elems[id].active = false;
+        wheel->active--;
+    }
+}
+
+// Process all the minutes up to the given timestamp, calling the visitor for each expired hold before removing it. Return the number of expired holds
+int holdWheel_advance(tHoldWheel* wheel, tDateTime now, tHoldVisitor visitor, void* context) {
+    tDateTimeKey target;
+    int level;
+    int slot;
+    int id;
+    int next;
+    int expired;
+    
+    assert(wheel != NULL);
+    
+    target = dateTime_toKey(now);
+    expired = 0;
+    
+    while (wheel->current < target) {
+        // Without active holds there is nothing to process until the target
+        if (wheel->active == 0) {
+            for (level = 0; level < HOLD_WHEEL_LEVELS; level++) {
+                for (slot = 0; slot < HOLD_WHEEL_SLOTS; slot++) {
+                    wheel->slots[level][slot] = -1;
+                }
+            }
+            wheel->current = target;
+            break;
+        }
+        
+        wheel->current++;
+        
+        // At the start of each period of a level, its holds are moved to the lower levels
+        for (level = 1; level < HOLD_WHEEL_LEVELS && (wheel->current & ((1u << (HOLD_WHEEL_BITS * level)) - 1)) == 0; level++) {
+            holdWheel_cascade(wheel, level);
+        }
+        
+        // Expire the holds of the current minute
+        slot = wheel->current & (HOLD_WHEEL_SLOTS - 1);
+        id = wheel->slots[0][slot];
+        wheel->slots[0][slot] = -1;
+        while (id >= 0) {
+            next = wheel->elems[id].next;
+            if (wheel->elems[id].active) {
+                if (visitor != NULL) {
+                    visitor(&(wheel->elems[id]), context);
+                }
+                wheel->elems[id].active = false;
+                wheel->active--;
+                expired++;
+            }
+            id = next;
+        }
+    }
+    
+    return expired;
+}
+
+// [AUX METHOD] Add a hold to the slot for its expiry
+void holdWheel_insert(tHoldWheel* wheel, int id) {
+    tDateTimeKey expiry;
+    tDateTimeKey delta;
+    int level;
+    int slot;
+    
+    expiry = wheel->elems[id].expiry;
+    
+    // Select the lowest level that covers the remaining minutes
+    delta = expiry - wheel->current;
+    level = 0;
+    while (level < HOLD_WHEEL_LEVELS - 1 && delta >= (1u << (HOLD_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    
+    slot = (expiry >> (HOLD_WHEEL_BITS * level)) & (HOLD_WHEEL_SLOTS - 1);
+    wheel->elems[id].next = wheel->slots[level][slot];
+    wheel->slots[level][slot] = id;
+}
+
+// [AUX METHOD] Move the holds of the current slot of a level to the lower levels
+void holdWheel_cascade(tHoldWheel* wheel, int level) {
+    int slot;
+    int id;
+    int next;
+    
+    slot = (wheel->current >> (HOLD_WHEEL_BITS * level)) & (HOLD_WHEEL_SLOTS - 1);
+    id = wheel->slots[level][slot];
+    wheel->slots[level][slot] = -1;
+    while (id >= 0) {
+        next = wheel->elems[id].next;
+        // Released holds are dropped
+        if (wheel->elems[id].active) {
+            holdWheel_insert(wheel, id);
+        }
+        id = next;
+    }
+}
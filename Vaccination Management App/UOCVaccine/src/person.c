@@ -11,7 +11,20 @@ void population_init(tPopulation* data) {
     assert(data != NULL);
     
     data->elems = NULL;
+    data->contacts = NULL;
     data->count = 0;
+    data->arena = NULL;
+    data->cps = NULL;
+    data->index = NULL;
+    data->indexSize = 0;
+    data->byCp = NULL;
+    data->byCpCount = 0;
+    bitmap_init(&(data->scheduled));
+    data->bookings = NULL;
+    data->byVaccine = NULL;
+    data->byVaccineCount = 0;
+    data->byBirthday = NULL;
+    data->byBirthdaySorted = true;
 }
 
 // Initialize a person structure
@@ -20,11 +33,9 @@ void person_init(tPerson* data) {
     assert(data != NULL);
     
     data->document = NULL;
-    data->name = NULL;
-    data->surname = NULL;
-    data->email = NULL;
-    data->address = NULL;
+    data->key = DOCUMENT_KEY_NONE;
     data->cp = NULL;
+    data->cpId = POSTAL_CODE_UNKNOWN;
     data->birthday.day=-1;
     data->birthday.month=-1;
     data->birthday.year=-1;
@@ -39,6 +50,27 @@ void person_free(tPerson* data) {
     if(data->document != NULL) free(data->document);
     data->document = NULL;
     
+    // Release cp data
+    if(data->cp != NULL) free(data->cp);
+    data->cp = NULL;
+}
+
+// Initialize a person contact structure
+void personContact_init(tPersonContact* data) {
+    // Check input data
+    assert(data != NULL);
+    
+    data->name = NULL;
+    data->surname = NULL;
+    data->email = NULL;
+    data->address = NULL;
+}
+
+// Remove the data from a person contact
+void personContact_free(tPersonContact* data) {
+    // Check input data
+    assert(data != NULL);
+    
     // Release name data
     if(data->name != NULL) free(data->name);
     data->name = NULL;
@@ -54,10 +86,6 @@ void person_free(tPerson* data) {
     // Release address data
     if(data->address != NULL) free(data->address);
     data->address = NULL;
-    
-    // Release cp data
-    if(data->cp != NULL) free(data->cp);
-    data->cp = NULL;
 }
 
 // Remove the data from all persons
@@ -67,75 +95,120 @@ void population_free(tPopulation* data) {
     // Check input data
     assert(data != NULL);
     
-    // Remove contents
-    for(i = 0; i < data->count; i++) {
-        person_free(&(data->elems[i]));
-    }    
+    // Remove contents. Strings stored on the arena are released with it
+    if (data->arena == NULL) {
+        for(i = 0; i < data->count; i++) {
+            // Interned cps are released with the postal code table
+            if (data->cps != NULL) {
+                data->elems[i].cp = NULL;
+            }
+            person_free(&(data->elems[i]));
+            personContact_free(&(data->contacts[i]));
+        }
+    }
     
     // Release memory
     if (data->count > 0) {
         free(data->elems);
+        free(data->contacts);
+        free(data->bookings);
         data->elems = NULL;
+        data->contacts = NULL;
+        data->bookings = NULL;
         data->count = 0;
     }
+    
+    // Release the hash table
+    if (data->index != NULL) {
+        free(data->index);
+        data->index = NULL;
+        data->indexSize = 0;
+    }
+    
+    // Release the sets of persons by cp
+    for (i = 0; i < data->byCpCount; i++) {
+        bitmap_free(&(data->byCp[i]));
+    }
+    if (data->byCp != NULL) {
+        free(data->byCp);
+        data->byCp = NULL;
+    }
+    data->byCpCount = 0;
+    
+    // Release the scheduled persons and the birthday index
+    bitmap_free(&(data->scheduled));
+    for (i = 0; i < data->byVaccineCount; i++) {
+        if (data->arena == NULL) {
+            free(data->byVaccine[i].vaccine);
+        }
+        bitmap_free(&(data->byVaccine[i].persons));
+    }
+    if (data->byVaccine != NULL) {
+        free(data->byVaccine);
+        data->byVaccine = NULL;
+    }
+    data->byVaccineCount = 0;
+    if (data->byBirthday != NULL) {
+        free(data->byBirthday);
+        data->byBirthday = NULL;
+    }
+    data->byBirthdaySorted = true;
 }
 
 
-// Parse input from CSVEntry
-void person_parse(tPerson* data, tCSVEntry entry) {
+// Parse input from CSVEntry, storing the contact data on contact. Return false if the entry is malformed
+bool person_parse(tPerson* data, tPersonContact* contact, tCSVEntry entry) {
+    tPerson view;
+    tPersonContact viewContact;
+    
     // Check input data
     assert(data != NULL);
+    assert(contact != NULL);
     
     // Check entry fields
     assert(csv_numFields(entry) == 7);
     
-    // Remove old data
-    person_free(data);
-      
-    // Copy identity document data
-    data->document = (char*) malloc((strlen(entry.fields[0]) + 1) * sizeof(char));
-    assert(data->document != NULL);
-    memset(data->document, 0, (strlen(entry.fields[0]) + 1) * sizeof(char));
-    csv_getAsString(entry, 0, data->document, strlen(entry.fields[0]) + 1);
-    
-    // Copy name data
-    data->name = (char*) malloc((strlen(entry.fields[1]) + 1) * sizeof(char));
-    assert(data->name != NULL);
-    memset(data->name, 0, (strlen(entry.fields[1]) + 1) * sizeof(char));
-    csv_getAsString(entry, 1, data->name, strlen(entry.fields[1]) + 1);
-    
-    // Copy surname data
-    data->surname = (char*) malloc((strlen(entry.fields[2]) + 1) * sizeof(char));
-    assert(data->surname != NULL);
-    memset(data->surname, 0, (strlen(entry.fields[2]) + 1) * sizeof(char));
-    csv_getAsString(entry, 2, data->surname, strlen(entry.fields[2]) + 1);
-    
-    // Copy email data
-    data->email = (char*) malloc((strlen(entry.fields[3]) + 1) * sizeof(char));
-    assert(data->email != NULL);
-    memset(data->email, 0, (strlen(entry.fields[3]) + 1) * sizeof(char));
-    csv_getAsString(entry, 3, data->email, strlen(entry.fields[3]) + 1);
-    
-    // Copy address data
-    data->address = (char*) malloc((strlen(entry.fields[4]) + 1) * sizeof(char));
-    assert(data->address != NULL);
-    memset(data->address, 0, (strlen(entry.fields[4]) + 1) * sizeof(char));
-    csv_getAsString(entry, 4, data->address, strlen(entry.fields[4]) + 1);
-    
-    // Copy cp data
-    data->cp = (char*) malloc((strlen(entry.fields[5]) + 1) * sizeof(char));
-    assert(data->cp != NULL);
-    memset(data->cp, 0, (strlen(entry.fields[5]) + 1) * sizeof(char));
-    csv_getAsString(entry, 5, data->cp, strlen(entry.fields[5]) + 1);
-    
-    // Check birthday lenght
-    assert(strlen(entry.fields[6]) == 10);
+    // Remove old contact data
+    personContact_free(contact);
+    
+    // Validate the fields
+    if (!person_parseView(&view, &viewContact, entry.fields)) {
+        person_free(data);
+        return false;
+    }
+    
+    // Copy the data
+    person_cpy(data, view);
+    personContact_cpyArena(contact, viewContact, NULL);
+    
+    return true;
+}
+
+// Parse the 7 fields of a person without copying them. Person and contact refer to the fields and must not be released. Contact can be NULL
+bool person_parseView(tPerson* data, tPersonContact* contact, char** fields) {
+    // Check input data
+    assert(data != NULL);
+    assert(fields != NULL);
+    
+    // Refer to the text fields
+    data->document = fields[0];
+    data->key = document_toKey(fields[0]);
+    data->cp = fields[5];
+    data->cpId = POSTAL_CODE_UNKNOWN;
+    
+    if (contact != NULL) {
+        contact->name = fields[1];
+        contact->surname = fields[2];
+        contact->email = fields[3];
+        contact->address = fields[4];
+    }
+    
     // Parse the birthday date
-    sscanf(entry.fields[6], "%d/%d/%d", &(data->birthday.day), &(data->birthday.month), &(data->birthday.year));
+    return date_parse(&(data->birthday), fields[6]);
 }
 
-// Add a new person
-void population_add(tPopulation* data, tPerson person) {
+// Add a new person with its contact data
+void population_add(tPopulation* data, tPerson person, tPersonContact contact) {
     // Check input data
     assert(data != NULL);
     
@@ -145,24 +218,48 @@ void population_add(tPopulation* data, tPerson person) {
         if (data->count == 0) {
             // Request new memory space
             data->elems = (tPerson*) malloc(sizeof(tPerson));            
+            data->contacts = (tPersonContact*) malloc(sizeof(tPersonContact));            
+            data->bookings = (tPersonBooking*) malloc(sizeof(tPersonBooking));            
         } else {
             // Modify currently allocated memory
             data->elems = (tPerson*) realloc(data->elems, (data->count + 1) * sizeof(tPerson));            
+            data->contacts = (tPersonContact*) realloc(data->contacts, (data->count + 1) * sizeof(tPersonContact));            
+            data->bookings = (tPersonBooking*) realloc(data->bookings, (data->count + 1) * sizeof(tPersonBooking));            
         }
         assert(data->elems != NULL);
+        assert(data->contacts != NULL);
+        assert(data->bookings != NULL);
         
         // Initialize the new element
         person_init(&(data->elems[data->count]));
+        personContact_init(&(data->contacts[data->count]));
+        data->bookings[data->count].centerId = POSTAL_CODE_UNKNOWN;
+        data->bookings[data->count].series = -1;
+        data->bookings[data->count].doses = 0;
+        data->bookings[data->count].waitingId = POSTAL_CODE_UNKNOWN;
+        data->bookings[data->count].hold = -1;
                 
         // Copy the data to the new position
-        person_cpy(&(data->elems[data->count]), person);
+        person_cpyArena(&(data->elems[data->count]), person, data->arena, data->cps);
+        personContact_cpyArena(&(data->contacts[data->count]), contact, data->arena);
         
         // Increase the number of elements
         data->count ++;
+        
+        // Index the new element
+        population_indexAdd(data, data->count - 1);
+        population_cpIndexAdd(data, data->count - 1);
+        
+        // Append the new element to the birthday index
+        data->byBirthday = (tBirthdayEntry*) realloc(data->byBirthday, data->count * sizeof(tBirthdayEntry));
+        assert(data->byBirthday != NULL);
+        data->byBirthday[data->count - 1].days = date_toDays(person.birthday);
+        data->byBirthday[data->count - 1].pos = data->count - 1;
+        data->byBirthdaySorted = false;
     }
 }
 
-// Remove a person
+// Remove a person. Positions stored on the centers are not updated, use api_deletePerson on the application data
 void population_del(tPopulation* data, const char *document) {
     int i;
     int pos;
@@ -174,12 +271,40 @@ void population_del(tPopulation* data, const char *document) {
     pos = population_find(data[0], document);
     
     if (pos >= 0) {
-        // Remove current position memory
-        person_free(&(data->elems[pos]));
+        // Remove current position memory. Strings stored on the arena are kept until it is released
+        if (data->arena == NULL) {
+            if (data->cps != NULL) {
+                data->elems[pos].cp = NULL;
+            }
+            person_free(&(data->elems[pos]));
+            personContact_free(&(data->contacts[pos]));
+        }
         // Shift elements 
         for(i = pos; i < data->count-1; i++) {
             // Copy address of element on position i+1 to position i
             data->elems[i] = data->elems[i+1];
+            data->contacts[i] = data->contacts[i+1];
+            data->bookings[i] = data->bookings[i+1];
+        }
+        
+        // Update the positions on the sets
+        bitmap_removeShift(&(data->scheduled), pos);
+        for(i = 0; i < data->byVaccineCount; i++) {
+            bitmap_removeShift(&(data->byVaccine[i].persons), pos);
+        }
+        for(i = 0; i < data->byCpCount; i++) {
+            bitmap_removeShift(&(data->byCp[i]), pos);
+        }
+        
+        // Remove the entry from the birthday index and update the next positions
+        data->byBirthdaySorted = false;
+        for(i = 0; i < data->count-1; i++) {
+            if (data->byBirthday[i].pos == pos) {
+                data->byBirthday[i] = data->byBirthday[data->count-1];
+            }
+            if (data->byBirthday[i].pos > pos) {
+                data->byBirthday[i].pos--;
+            }
         }
         // Update the number of elements
         data->count--;
@@ -187,42 +312,408 @@ void population_del(tPopulation* data, const char *document) {
         if (data->count == 0) {
             // No element remaining
             free(data->elems);
+            free(data->contacts);
+            free(data->bookings);
             data->elems = NULL;
+            data->contacts = NULL;
+            data->bookings = NULL;
         } else {
             // Still some elements are remaining
             data->elems = (tPerson*)realloc(data->elems, data->count * sizeof(tPerson));
+            data->contacts = (tPersonContact*)realloc(data->contacts, data->count * sizeof(tPersonContact));
+            data->bookings = (tPersonBooking*)realloc(data->bookings, data->count * sizeof(tPersonBooking));
         }
+        // Positions after the removed one have changed
+        population_indexBuild(data, data->indexSize);
     }
 }
 
 // Return the position of a person with provided document. -1 if it does not exist
 int population_find(tPopulation data, const char* document) {
-    int i;
+    tDocumentKey key;
+    int slot;
     
-    for(i = 0; i < data.count; i++) {
-        if(strcmp(data.elems[i].document, document) == 0 ) {
-            return i;
+    assert(document != NULL);
+    
+    if (data.index == NULL) {
+        return -1;
+    }
+    
+    // Linear probing on the hash table, comparing the packed documents
+    key = document_toKey(document);
+    slot = (int)(document_hash(key, document) & (uint32_t)(data.indexSize - 1));
+    while (data.index[slot] >= 0) {
+        if (document_equals(data.elems[data.index[slot]].key, data.elems[data.index[slot]].document, key, document)) {
+            return data.index[slot];
         }
+        slot = (slot + 1) & (data.indexSize - 1);
     }
     
     return -1;
 }
 
+// Call the visitor for each person with the given interned cp. Return the number of visited persons
+int population_visitCp(tPopulation* data, int cpId, tPersonVisitor visitor, void* context) {
+    const tBitmap *pSet;
+    
+    assert(data != NULL);
+    assert(visitor != NULL);
+    
+    pSet = population_getCpSet(data, cpId);
+    if (pSet == NULL) {
+        return 0;
+    }
+    
+    return population_visitSet(data, pSet, visitor, context);
+}
+
+// Call the visitor for each person on the set of positions. Return the number of visited persons
+int population_visitSet(tPopulation* data, const tBitmap* persons, tPersonVisitor visitor, void* context) {
+    tPopulationVisit visit;
+    
+    assert(data != NULL);
+    assert(persons != NULL);
+    assert(visitor != NULL);
+    
+    // Persons are visited in population order
+    visit.elems = data->elems;
+    visit.visitor = visitor;
+    visit.context = context;
+    bitmap_visit(persons, population_visitPosition, &visit);
+    
+    return bitmap_cardinality(persons);
+}
+
+// Call the person visitor of a population visit for a position
+void population_visitPosition(uint32_t pos, void* context) {
+    tPopulationVisit *pVisit = (tPopulationVisit*) context;
+    
+    pVisit->visitor(&(pVisit->elems[pos]), pVisit->context);
+}
+
+// Get the positions of the persons with the given interned cp. NULL if there are none
+const tBitmap* population_getCpSet(tPopulation* data, int cpId) {
+    assert(data != NULL);
+    
+    if (cpId < 0 || cpId >= data->byCpCount) {
+        return NULL;
+    }
+    
+    return &(data->byCp[cpId]);
+}
+
+// Store on result the positions of the persons born before the cutoff. Result must be initialized and is replaced
+void population_getBornBefore(tPopulation* data, tDate cutoff, tBitmap* result) {
+    tBitmap persons;
+    int days;
+    int i;
+    
+    assert(data != NULL);
+    assert(result != NULL);
+    
+    // Sort the persons added or removed since the last query
+    if (!data->byBirthdaySorted) {
+        population_birthdayIndexBuild(data);
+    }
+    
+    // Walk the index up to the cutoff
+    bitmap_init(&persons);
+    days = date_toDays(cutoff);
+    for (i = 0; i < data->count && data->byBirthday[i].days < days; i++) {
+        bitmap_add(&persons, data->byBirthday[i].pos);
+    }
+    
+    bitmap_free(result);
+    *result = persons;
+}
+
+// Get the positions of the persons with appointments for the given vaccine, or any vaccine if it is NULL. NULL if there are none
+const tBitmap* population_getScheduledSet(tPopulation* data, const char* vaccine) {
+    int i;
+    
+    assert(data != NULL);
+    
+    if (vaccine == NULL) {
+        return &(data->scheduled);
+    }
+    for (i = 0; i < data->byVaccineCount; i++) {
+        if (strcmp(data->byVaccine[i].vaccine, vaccine) == 0) {
+            return &(data->byVaccine[i].persons);
+        }
+    }
+    
+    return NULL;
+}
+
+// Mark the person on the given position as scheduled or not. Unscheduled persons are removed from all the vaccine sets
+void population_setScheduled(tPopulation* data, int pos, bool scheduled) {
+    int i;
+    
+    assert(data != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    if (scheduled) {
+        bitmap_add(&(data->scheduled), pos);
+    } else {
+        bitmap_remove(&(data->scheduled), pos);
+        for (i = 0; i < data->byVaccineCount; i++) {
+            bitmap_remove(&(data->byVaccine[i].persons), pos);
+        }
+    }
+}
+
+// Mark the person on the given position as scheduled for a vaccine
+void population_setScheduledVaccine(tPopulation* data, int pos, const char* vaccine) {
+    int i;
+    
+    assert(data != NULL);
+    assert(vaccine != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    // Find the set of this vaccine, adding it the first time
+    for (i = 0; i < data->byVaccineCount && strcmp(data->byVaccine[i].vaccine, vaccine) != 0; i++);
+    if (i == data->byVaccineCount) {
+        data->byVaccine = (tVaccinePersons*) realloc(data->byVaccine, (data->byVaccineCount + 1) * sizeof(tVaccinePersons));
+        assert(data->byVaccine != NULL);
+        data->byVaccine[i].vaccine = stringArena_strdup(data->arena, vaccine);
+        bitmap_init(&(data->byVaccine[i].persons));
+        data->byVaccineCount++;
+    }
+    
+    bitmap_add(&(data->byVaccine[i].persons), pos);
+    bitmap_add(&(data->scheduled), pos);
+}
+
+// Check if the person on the given position has appointments
+bool population_isScheduled(tPopulation* data, int pos) {
+    assert(data != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    return bitmap_contains(&(data->scheduled), pos);
+}
+
+// Set the center where the person on the given position is waiting for vaccines
+void population_setWaiting(tPopulation* data, int pos, int centerId) {
+    assert(data != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    data->bookings[pos].waitingId = centerId;
+}
+
+// Store the booking of the person on the given position and mark it as scheduled for the vaccine. The person stops waiting
+void population_setBooking(tPopulation* data, int pos, int centerId, int series, const char* vaccine, int doses) {
+    assert(data != NULL);
+    assert(vaccine != NULL);
+    assert(pos >= 0 && pos < data->count);
+    assert(doses > 0);
+    
+    data->bookings[pos].centerId = centerId;
+    data->bookings[pos].series = series;
+    data->bookings[pos].doses = doses;
+    data->bookings[pos].waitingId = POSTAL_CODE_UNKNOWN;
+    population_setScheduledVaccine(data, pos, vaccine);
+}
+
+// [AUX METHOD] Remove the booking of the person on the given position and mark it as not scheduled. Bookings are cancelled with api_cancelAppointment, which also releases the series
+void population_clearBooking(tPopulation* data, int pos) {
+    assert(data != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    data->bookings[pos].centerId = POSTAL_CODE_UNKNOWN;
+    data->bookings[pos].series = -1;
+    data->bookings[pos].doses = 0;
+    population_setScheduled(data, pos, false);
+}
+
+// Set the active hold of the person on the given position. -1 if it has none
+void population_setHold(tPopulation* data, int pos, int hold) {
+    assert(data != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    data->bookings[pos].hold = hold;
+}
+
+// Get the booking state of the person on the given position
+const tPersonBooking* population_getBooking(tPopulation* data, int pos) {
+    assert(data != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    return &(data->bookings[pos]);
+}
+
+// Check if the person on the given position is booked in any center
+bool population_isBooked(tPopulation* data, int pos) {
+    assert(data != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    return data->bookings[pos].doses > 0;
+}
+
+// Call the visitor for each person without appointments born before the cutoff, from the oldest one. If cpId is not POSTAL_CODE_UNKNOWN only persons on this cp are visited. Return the number of visited persons
+int population_visitEligible(tPopulation* data, tDate cutoff, int cpId, tPersonVisitor visitor, void* context) {
+    int days;
+    int pos;
+    int i;
+    int visited;
+    
+    assert(data != NULL);
+    assert(visitor != NULL);
+    
+    // Sort the persons added or removed since the last query
+    if (!data->byBirthdaySorted) {
+        population_birthdayIndexBuild(data);
+    }
+    
+    // Walk the index up to the cutoff, skipping scheduled persons with the bitmap
+    days = date_toDays(cutoff);
+    visited = 0;
+    for (i = 0; i < data->count && data->byBirthday[i].days < days; i++) {
+        pos = data->byBirthday[i].pos;
+        if (!population_isScheduled(data, pos) && (cpId == POSTAL_CODE_UNKNOWN || data->elems[pos].cpId == cpId)) {
+            visitor(&(data->elems[pos]), context);
+            visited++;
+        }
+    }
+    
+    return visited;
+}
+
+// Sort the birthday index
+void population_birthdayIndexBuild(tPopulation* data) {
+    assert(data != NULL);
+    
+    if (data->count > 0) {
+        qsort(data->byBirthday, data->count, sizeof(tBirthdayEntry), population_birthdayCmp);
+    }
+    data->byBirthdaySorted = true;
+}
+
+// Compare two entries of the birthday index
+int population_birthdayCmp(const void* a, const void* b) {
+    const tBirthdayEntry *pA = (const tBirthdayEntry*) a;
+    const tBirthdayEntry *pB = (const tBirthdayEntry*) b;
+    
+    if (pA->days != pB->days) {
+        return pA->days < pB->days ? -1 : 1;
+    }
+    return pA->pos < pB->pos ? -1 : (pA->pos > pB->pos ? 1 : 0);
+}
+
+// Add the person on the given position to the set of its cp
+void population_cpIndexAdd(tPopulation* data, int pos) {
+    int cpId;
+    int i;
+    
+    assert(data != NULL);
+    
+    cpId = data->elems[pos].cpId;
+    if (cpId == POSTAL_CODE_UNKNOWN) {
+        return;
+    }
+    
+    // Add the sets up to this cp
+    if (cpId >= data->byCpCount) {
+        data->byCp = (tBitmap*) realloc(data->byCp, (cpId + 1) * sizeof(tBitmap));
+        assert(data->byCp != NULL);
+        for (i = data->byCpCount; i <= cpId; i++) {
+            bitmap_init(&(data->byCp[i]));
+        }
+        data->byCpCount = cpId + 1;
+    }
+    
+    bitmap_add(&(data->byCp[cpId]), pos);
+}
+
+// Add the person on the given position to the hash table, growing it if needed
+void population_indexAdd(tPopulation* data, int pos) {
+    int slot;
+    tPerson *pPerson;
+    
+    assert(data != NULL);
+    
+    // Keep the load of the hash table under one half
+    if (data->index == NULL || 2 * data->count > data->indexSize) {
+        population_indexBuild(data, data->indexSize == 0 ? POPULATION_INDEX_SIZE : 2 * data->indexSize);
+        return;
+    }
+    
+    pPerson = &(data->elems[pos]);
+    slot = (int)(document_hash(pPerson->key, pPerson->document) & (uint32_t)(data->indexSize - 1));
+    while (data->index[slot] >= 0) {
+        slot = (slot + 1) & (data->indexSize - 1);
+    }
+    data->index[slot] = pos;
+}
+
+// Create again the hash table with the given number of positions
+void population_indexBuild(tPopulation* data, int size) {
+    int i;
+    int slot;
+    
+    assert(data != NULL);
+    
+    if (data->index != NULL) {
+        free(data->index);
+        data->index = NULL;
+        data->indexSize = 0;
+    }
+    if (data->count == 0) {
+        return;
+    }
+    
+    // The size is a power of two
+    data->index = (int*) malloc(size * sizeof(int));
+    assert(data->index != NULL);
+    data->indexSize = size;
+    for (i = 0; i < size; i++) {
+        data->index[i] = -1;
+    }
+    
+    // Place all the persons
+    for (i = 0; i < data->count; i++) {
+        slot = (int)(document_hash(data->elems[i].key, data->elems[i].document) & (uint32_t)(size - 1));
+        while (data->index[slot] >= 0) {
+            slot = (slot + 1) & (size - 1);
+        }
+        data->index[slot] = i;
+    }
+}
+
 // Print the person data
 void population_print(tPopulation data) {
+    tReportWriter writer;
+    
+    writer_initFile(&writer, stdout, REPORT_CSV);
+    population_write(data, &writer);
+    writer_free(&writer);
+}
+
+// Write the person data with the format of population_print
+void population_write(tPopulation data, tReportWriter* writer) {
     int i;
     
     for(i = 0; i < data.count; i++) {
-        // Print position and document
-        printf("%d;%s;", i, data.elems[i].document);
-        // Print name and surname
-        printf("%s;%s;", data.elems[i].name, data.elems[i].surname);        
-        // Print email
-        printf("%s;", data.elems[i].email);
-        // Print address and CP
-        printf("%s;%s;", data.elems[i].address, data.elems[i].cp);
-        // Print birthday date
-        printf("%02d/%02d/%04d\n", data.elems[i].birthday.day, data.elems[i].birthday.month, data.elems[i].birthday.year);
+        // Position and document
+        writer_putInt(writer, i);
+        writer_putChar(writer, ';');
+        writer_putStr(writer, data.elems[i].document);
+        writer_putChar(writer, ';');
+        // Name and surname
+        writer_putStr(writer, data.contacts[i].name);
+        writer_putChar(writer, ';');
+        writer_putStr(writer, data.contacts[i].surname);
+        writer_putChar(writer, ';');
+        // Email
+        writer_putStr(writer, data.contacts[i].email);
+        writer_putChar(writer, ';');
+        // Address and CP
+        writer_putStr(writer, data.contacts[i].address);
+        writer_putChar(writer, ';');
+        writer_putStr(writer, data.elems[i].cp);
+        writer_putChar(writer, ';');
+        // Birthday date
+        writer_putDate(writer, data.elems[i].birthday);
+        writer_putChar(writer, '\n');
     }
 }
 
@@ -232,40 +723,50 @@ void person_cpy(tPerson* destination, tPerson source) {
     // Remove old data
     person_free(destination);
     
+    // Copy the data
+    person_cpyArena(destination, source, NULL, NULL);
+}
+
+// Copy the data from the source to an empty destination, storing the strings on the arena. If arena is NULL they are allocated with malloc. If cps is not NULL, the cp refers to the interned one
+void person_cpyArena(tPerson* destination, tPerson source, tStringArena* arena, tPostalCodeTable* cps) {
+    assert(destination != NULL);
+    
     // Copy identity document data
-    destination->document = (char*) malloc((strlen(source.document) + 1) * sizeof(char));
-    assert(destination->document != NULL);
-    strcpy(destination->document, source.document);
-    
-    // Copy name data
-    destination->name = (char*) malloc((strlen(source.name) + 1) * sizeof(char));
-    assert(destination->name != NULL);
-    strcpy(destination->name, source.name);
-    
-    // Copy surname data
-    destination->surname = (char*) malloc((strlen(source.surname) + 1) * sizeof(char));
-    assert(destination->surname != NULL);
-    strcpy(destination->surname, source.surname);
-    
-    // Copy email data
-    destination->email = (char*) malloc((strlen(source.email) + 1) * sizeof(char));
-    assert(destination->email != NULL);
-    strcpy(destination->email, source.email);
-    
-    // Copy address data
-    destination->address = (char*) malloc((strlen(source.address) + 1) * sizeof(char));
-    assert(destination->address != NULL);
-    strcpy(destination->address, source.address);
-    
-    // Copy cp data
-    destination->cp = (char*) malloc((strlen(source.cp) + 1) * sizeof(char));
-    assert(destination->cp != NULL);
-    strcpy(destination->cp, source.cp);
+    destination->document = stringArena_strdup(arena, source.document);
+    destination->key = document_toKey(source.document);
+    
+    // Copy cp data, or refer to the interned one
+    if (cps != NULL) {
+        destination->cpId = postalCodeTable_intern(cps, source.cp);
+        destination->cp = (char*) postalCodeTable_get(cps, destination->cpId);
+    } else {
+        destination->cpId = source.cpId;
+        destination->cp = stringArena_strdup(arena, source.cp);
+    }
     
     // Copy the birthday date
     destination->birthday = source.birthday;
 }
 
+// Copy the data from the source to an empty destination, storing the strings on the arena. If arena is NULL they are allocated with malloc
+void personContact_cpyArena(tPersonContact* destination, tPersonContact source, tStringArena* arena) {
+    assert(destination != NULL);
+    
+    // Copy the available fields
+    destination->name = source.name == NULL ? NULL : stringArena_strdup(arena, source.name);
+    destination->surname = source.surname == NULL ? NULL : stringArena_strdup(arena, source.surname);
+    destination->email = source.email == NULL ? NULL : stringArena_strdup(arena, source.email);
+    destination->address = source.address == NULL ? NULL : stringArena_strdup(arena, source.address);
+}
+
+// Get the contact data of the person on the given position
+tPersonContact* population_getContact(tPopulation* data, int pos) {
+    assert(data != NULL);
+    assert(pos >= 0 && pos < data->count);
+    
+    return &(data->contacts[pos]);
+}
+
 // Return population lenght
 int population_len(tPopulation data) {
     return data.count;
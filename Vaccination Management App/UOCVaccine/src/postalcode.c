@@ -0,0 +1,135 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "postalcode.h"
+
+// Initialize the table. The canonical strings are stored on the arena, if any
+void postalCodeTable_init(tPostalCodeTable* table, tStringArena* arena) {
+    int i;
+    
+    assert(table != NULL);
+    
+    table->codes = NULL;
+    table->count = 0;
+    table->arena = arena;
+    table->size = POSTAL_CODE_TABLE_SIZE;
+    table->slots = (int*) malloc(table->size * sizeof(int));
+    assert(table->slots != NULL);
+    for (i = 0; i < table->size; i++) {
+        table->slots[i] = POSTAL_CODE_UNKNOWN;
+    }
+}
+
+// Release the table data
+void postalCodeTable_free(tPostalCodeTable* table) {
+    int i;
+    
+    assert(table != NULL);
+    
+    // Strings stored on the arena are released with it
+    if (table->arena == NULL) {
+        for (i = 0; i < table->count; i++) {
+            free(table->codes[i]);
+        }
+    }
+    if (table->codes != NULL) {
+        free(table->codes);
+    }
+    if (table->slots != NULL) {
+        free(table->slots);
+    }
+    table->codes = NULL;
+    table->slots = NULL;
+    table->count = 0;
+    table->size = 0;
+}
+
+// Get the position of the hash table for a postal code, empty or holding its identifier
+int postalCodeTable_slot(tPostalCodeTable* table, const char* cp) {
+    uint32_t hash;
+    int pos;
+    const char *pChar;
+    
+    // FNV-1a hash of the code
+    hash = 2166136261u;
+    for (pChar = cp; *pChar != '\0'; pChar++) {
+        hash = (hash ^ (uint8_t)(*pChar)) * 16777619u;
+    }
+    
+    // Linear probing. The size is a power of two
+    pos = (int)(hash & (uint32_t)(table->size - 1));
+    while (table->slots[pos] != POSTAL_CODE_UNKNOWN && strcmp(table->codes[table->slots[pos]], cp) != 0) {
+        pos = (pos + 1) & (table->size - 1);
+    }
+    
+    return pos;
+}
+
+// Double the size of the hash table
+void postalCodeTable_grow(tPostalCodeTable* table) {
+    int i;
+    
+    free(table->slots);
+    table->size *= 2;
+    table->slots = (int*) malloc(table->size * sizeof(int));
+    assert(table->slots != NULL);
+    for (i = 0; i < table->size; i++) {
+        table->slots[i] = POSTAL_CODE_UNKNOWN;
+    }
+    
+    // Place again all the codes
+    for (i = 0; i < table->count; i++) {
+        table->slots[postalCodeTable_slot(table, table->codes[i])] = i;
+    }
+}
+
+// Get the identifier of a postal code. POSTAL_CODE_UNKNOWN if it is not in the table
+int postalCodeTable_find(tPostalCodeTable* table, const char* cp) {
+    assert(table != NULL);
+    assert(cp != NULL);
+    
+    return table->slots[postalCodeTable_slot(table, cp)];
+}
+
+// Get the identifier of a postal code, adding it if it is not in the table
+int postalCodeTable_intern(tPostalCodeTable* table, const char* cp) {
+    int pos;
+    
+    assert(table != NULL);
+    assert(cp != NULL);
+    
+    pos = postalCodeTable_slot(table, cp);
+    if (table->slots[pos] != POSTAL_CODE_UNKNOWN) {
+        return table->slots[pos];
+    }
+    
+    // Add the canonical string
+    table->codes = (char**) realloc(table->codes, (table->count + 1) * sizeof(char*));
+    assert(table->codes != NULL);
+    table->codes[table->count] = stringArena_strdup(table->arena, cp);
+    table->slots[pos] = table->count;
+    table->count++;
+    
+    // Keep the load of the hash table under one half
+    if (2 * table->count > table->size) {
+        postalCodeTable_grow(table);
+    }
+    
+    return table->count - 1;
+}
+
+// Get the canonical string of a postal code identifier
+const char* postalCodeTable_get(tPostalCodeTable* table, int id) {
+    assert(table != NULL);
+    assert(id >= 0 && id < table->count);
+    
+    return table->codes[id];
+}
+
+// Get the number of postal codes
+int postalCodeTable_len(tPostalCodeTable* table) {
+    assert(table != NULL);
+    
+    return table->count;
+}
@@ -0,0 +1,194 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "slots.h"
+
+// Initialize a calendar without limit
+void slotCalendar_init(tSlotCalendar* calendar) {
+    int i;
+    
+    assert(calendar != NULL);
+    
+    calendar->capacity = 0;
+    for (i = 0; i < SLOT_WORDS; i++) {
+        calendar->open[i] = 0;
+    }
+    calendar->firstDay = 0;
+    calendar->days = NULL;
+    calendar->count = 0;
+}
+
+// Release the calendar data
+void slotCalendar_free(tSlotCalendar* calendar) {
+    assert(calendar != NULL);
+    
+    if (calendar->days != NULL) {
+        free(calendar->days);
+    }
+    slotCalendar_init(calendar);
+}
+
+// Set the appointments per slot and the opening hours, from the open time to the slot before the close time. A capacity of 0 removes the limit
+void slotCalendar_setCapacity(tSlotCalendar* calendar, int capacity, tTime open, tTime close) {
+    int slot;
+    int day;
+    
+    assert(calendar != NULL);
+    assert(capacity >= 0);
+    
+    calendar->capacity = capacity;
+    for (slot = 0; slot < SLOTS_PER_DAY; slot++) {
+        if (slot >= slot_fromTime(open) && slot < slot_fromTime(close)) {
+            calendar->open[slot / 64] |= (uint64_t)1 << (slot % 64);
+        } else {
+            calendar->open[slot / 64] &= ~((uint64_t)1 << (slot % 64));
+        }
+    }
+    
+    // Slots with the previous appointments can be full with the new capacity
+    for (day = 0; day < calendar->count; day++) {
+        for (slot = 0; slot < SLOTS_PER_DAY; slot++) {
+            slotCalendar_updateFull(calendar, &(calendar->days[day]), slot);
+        }
+    }
+}
+
+// Add appointments to the slot of a timestamp. Negative values remove them
+void slotCalendar_update(tSlotCalendar* calendar, tDateTime timestamp, int appointments) {
+    tSlotDay* pDay;
+    int slot;
+    
+    assert(calendar != NULL);
+    
+    pDay = slotCalendar_getDay(calendar, date_toDays(timestamp.date), true);
+    slot = slot_fromTime(timestamp.time);
+    assert(pDay->used[slot] + appointments >= 0);
+    pDay->used[slot] += appointments;
+    slotCalendar_updateFull(calendar, pDay, slot);
+}
+
+// Get the number of appointments on the slot of a timestamp
+int slotCalendar_getUsed(tSlotCalendar* calendar, tDateTime timestamp) {
+    tSlotDay* pDay;
+    
+    assert(calendar != NULL);
+    
+    pDay = slotCalendar_getDay(calendar, date_toDays(timestamp.date), false);
+    if (pDay == NULL) {
+        return 0;
+    }
+    
+    return pDay->used[slot_fromTime(timestamp.time)];
+}
+
+// Get the first open slot not before the given one that is free on the day and the following doses. SLOT_NOT_FOUND if there is none
+int slotCalendar_findFirst(tSlotCalendar* calendar, int day, int interval, int doses, int slot) {
+    uint64_t freeSlots[SLOT_WORDS];
+    tSlotDay* pDay;
+    int dose;
+    int i;
+    
+    assert(calendar != NULL);
+    assert(doses > 0);
+    
+    if (slot < 0 || slot >= SLOTS_PER_DAY) {
+        return SLOT_NOT_FOUND;
+    }
+    
+    // Without limit, any slot is free
+    if (calendar->capacity == 0) {
+        return slot;
+    }
+    
+    // Keep the open slots that are not full on any dose day
+    for (i = 0; i < SLOT_WORDS; i++) {
+        freeSlots[i] = calendar->open[i];
+    }
+    for (dose = 0; dose < doses; dose++) {
+        pDay = slotCalendar_getDay(calendar, day + dose * interval, false);
+        if (pDay != NULL) {
+            for (i = 0; i < SLOT_WORDS; i++) {
+                freeSlots[i] &= ~pDay->full[i];
+            }
+        }
+    }
+    
+    // Discard the slots before the given one
+    freeSlots[slot / 64] &= ~(((uint64_t)1 << (slot % 64)) - 1);
+    for (i = 0; i < slot / 64; i++) {
+        freeSlots[i] = 0;
+    }
+    
+    for (i = 0; i < SLOT_WORDS; i++) {
+        if (freeSlots[i] != 0) {
+            return i * 64 + __builtin_ctzll(freeSlots[i]);
+        }
+    }
+    
+    return SLOT_NOT_FOUND;
+}
+
+// Get the slot of a time
+int slot_fromTime(tTime time) {
+    return (time.hour * 60 + time.minutes) / SLOT_MINUTES;
+}
+
+// Get the start time of a slot
+tTime slot_toTime(int slot) {
+    tTime time;
+    
+    assert(slot >= 0 && slot < SLOTS_PER_DAY);
+    
+    time.hour = slot * SLOT_MINUTES / 60;
+    time.minutes = slot * SLOT_MINUTES % 60;
+    
+    return time;
+}
+
+// [AUX METHOD] Get a day of the calendar, adding it if create is true. NULL if it does not exist
+tSlotDay* slotCalendar_getDay(tSlotCalendar* calendar, int day, bool create) {
+    int first;
+    int count;
+    
+    if (calendar->count > 0 && day >= calendar->firstDay && day < calendar->firstDay + calendar->count) {
+        return &(calendar->days[day - calendar->firstDay]);
+    }
+    if (!create) {
+        return NULL;
+    }
+    
+    // Extend the range of days to include the new one
+    if (calendar->count == 0) {
+        first = day;
+        count = 1;
+    } else if (day < calendar->firstDay) {
+        first = day;
+        count = calendar->firstDay + calendar->count - day;
+    } else {
+        first = calendar->firstDay;
+        count = day - calendar->firstDay + 1;
+    }
+    calendar->days = (tSlotDay*) realloc(calendar->days, count * sizeof(tSlotDay));
+    assert(calendar->days != NULL);
+    
+    // Move the current days to their new position and clear the new ones
+    if (calendar->count > 0 && first < calendar->firstDay) {
+        memmove(&(calendar->days[calendar->firstDay - first]), calendar->days, calendar->count * sizeof(tSlotDay));
+        memset(calendar->days, 0, (calendar->firstDay - first) * sizeof(tSlotDay));
+    } else {
+        memset(&(calendar->days[calendar->count]), 0, (count - calendar->count) * sizeof(tSlotDay));
+    }
+    calendar->firstDay = first;
+    calendar->count = count;
+    
+    return &(calendar->days[day - first]);
+}
+
+// [AUX METHOD] Update the bit of a slot on the full bitmap
+void slotCalendar_updateFull(tSlotCalendar* calendar, tSlotDay* day, int slot) {
+    if (calendar->capacity > 0 && day->used[slot] >= calendar->capacity) {
+        day->full[slot / 64] |= (uint64_t)1 << (slot % 64);
+    } else {
+        day->full[slot / 64] &= ~((uint64_t)1 << (slot % 64));
+    }
+}
@@ -12,10 +12,15 @@ void stockList_init(tVaccineStockData* list) {
     list->count = 0;
     list->first = NULL;
     list->last = NULL;
+    list->days = NULL;
+    list->epoch = 0;
+    list->timelines = NULL;
+    list->timelineCount = 0;
+    list->stale = false;
     /////////////////
 }
 
-// Modify the doses of a certain vaccine
+// Modify the doses of a certain vaccine. If the daily list is not up to date only the timeline is modified
 void stockList_update(tVaccineStockData* list, tDate date, tVaccine* vaccine, int doses) {
     // PR2 Ex 1b
     tDate today;
@@ -25,6 +30,18 @@ void stockList_update(tVaccineStockData* list, tDate date, tVaccine* vaccine, in
     
     assert(list != NULL);
     
+    // A daily list that is not up to date is rebuilt from the timelines when it is read, so only the timeline is modified
+    if (list->stale) {
+        stockList_adjust(list, date, vaccine, doses);
+        return;
+    }
+    
+    // Invalidate any answer computed with the previous stock
+    list->epoch++;
+    
+    // Keep the timeline of the vaccine up to date
+    timeline_update(stockList_getTimeline(list, vaccine, true), date_toDays(date), doses);
+    
     // If the list is empty, just add a new element
     if (list->count == 0) {
         // Create the new element
@@ -69,17 +86,15 @@ void stockList_update(tVaccineStockData* list, tDate date, tVaccine* vaccine, in
 // Get the number of doses for a certain vaccine and date
 int stockList_getDoses(tVaccineStockData* list, tDate date, tVaccine* vaccine) {
     // PR2 Ex 1c
-    tVaccineDailyStock *pNode = NULL;
+    tStockTimeline *pTimeline = NULL;
     int numDoses = 0;
     assert(list != NULL);
     
-    pNode = stockList_find(list, date);
-    
-    if (pNode != NULL) {
-        numDoses = stockNode_getDoses(pNode->first, vaccine);
-    } else if(date_cmp(list->last->day, date) < 0) {
-        numDoses = stockNode_getDoses(list->last->first, vaccine);
-    }    
+    // The timeline has the same doses than the daily list, even if the list is not up to date
+    pTimeline = stockList_getTimeline(list, vaccine, false);
+    if (pTimeline != NULL) {
+        numDoses = timeline_getDoses(pTimeline, date_toDays(date));
+    }
     
     return numDoses;
     /////////////////
@@ -90,6 +105,7 @@ int stockList_getDoses(tVaccineStockData* list, tDate date, tVaccine* vaccine) {
 void stockList_free(tVaccineStockData* list) {
     // PR2 Ex 2b
     tVaccineDailyStock* pNode;
+    int i;
     
     assert(list != NULL);
     
@@ -105,6 +121,21 @@ void stockList_free(tVaccineStockData* list) {
     }
     list->first = NULL;
     list->last = NULL;
+    if (list->days != NULL) {
+        free(list->days);
+    }
+    list->days = NULL;
+    
+    // Remove the timelines
+    for (i = 0; i < list->timelineCount; i++) {
+        timeline_free(&(list->timelines[i]));
+    }
+    if (list->timelines != NULL) {
+        free(list->timelines);
+    }
+    list->timelines = NULL;
+    list->timelineCount = 0;
+    list->stale = false;
     /////////////////
 }
 
@@ -277,21 +308,18 @@ void dailyStock_copy(tVaccineDailyStock* src, tVaccineDailyStock* dst) {
 
 // Find the stock for a given date
 tVaccineDailyStock* stockList_find(tVaccineStockData* list, tDate date) {
-    tVaccineDailyStock *pNode;
     tVaccineDailyStock *pDate;
+    int offset;
     
     assert(list != NULL);
     
-    // Find the node
+    // Days are consecutive, so the position of the node is its distance in days to the first node
     pDate = NULL;
-    if (list->count > 0 && date_cmp(list->first->day, date) <= 0 && date_cmp(list->last->day, date) >= 0) {
-        pNode = list->first;
-        while(pNode != NULL && pDate == NULL) {
-            if(date_cmp(pNode->day, date) == 0) {
-                // Point current node
-                pDate = pNode;
-            }
-            pNode = pNode->next;
+    if (list->count > 0) {
+        offset = date_diffDays(list->first->day, date);
+        if (offset >= 0 && offset < list->count) {
+            pDate = list->days[offset];
+            assert(date_cmp(pDate->day, date) == 0);
         }
     }
     
@@ -349,6 +377,35 @@ void stockList_purge(tVaccineStockData* list) {
         }
         list->last = pAux;
     }
+    
+    stockList_index(list);
+}
+
+// Rebuild the index of the daily nodes after the list has been modified
+void stockList_index(tVaccineStockData* list) {
+    tVaccineDailyStock *pNode;
+    int i;
+    
+    assert(list != NULL);
+    
+    if (list->count == 0) {
+        if (list->days != NULL) {
+            free(list->days);
+        }
+        list->days = NULL;
+        list->last = NULL;
+        return;
+    }
+    
+    list->days = (tVaccineDailyStock**) realloc(list->days, list->count * sizeof(tVaccineDailyStock*));
+    assert(list->days != NULL);
+    
+    pNode = list->first;
+    for (i = 0; i < list->count; i++) {
+        assert(pNode != NULL);
+        list->days[i] = pNode;
+        pNode = pNode->next;
+    }
 }
 
 
@@ -376,6 +433,8 @@ void stockList_expandLeft(tVaccineStockData* list, tDate date) {
         // Decrement the date
         date_addDay(&today, -1);
     }
+    
+    stockList_index(list);
 }
 
 // Extend the list to the right with the data of the last position
@@ -400,28 +459,196 @@ void stockList_expandRight(tVaccineStockData* list, tDate date) {
         // Increment the date
         date_addDay(&today, 1);
     }
+    
+    stockList_index(list);
 }
 
 // Print stock list
 void stockList_print(tVaccineStockData list) {
+    tReportWriter writer;
+    
+    writer_initFile(&writer, stdout, REPORT_CSV);
+    stockList_write(list, &writer);
+    writer_free(&writer);
+}
+
+// Write the stock list with the format of stockList_print
+void stockList_write(tVaccineStockData list, tReportWriter* writer) {
     tVaccineDailyStock* pDay;
     tVaccineStockNode* pNode;
     bool first;
     
     pDay = list.first;    
     while(pDay != NULL) {        
-        printf("%02d/%02d/%04d => ", pDay->day.day, pDay->day.month, pDay->day.year);        
+        writer_putDate(writer, pDay->day);
+        writer_putStr(writer, " => ");
         pNode = pDay->first; 
         first = true;
         while(pNode != NULL) {
             if (!first) {
-                printf(" - ");
+                writer_putStr(writer, " - ");
             }
-            printf("%s [%d]", pNode->elem.vaccine->name, pNode->elem.doses);
+            writer_putStr(writer, pNode->elem.vaccine->name);
+            writer_putStr(writer, " [");
+            writer_putInt(writer, pNode->elem.doses);
+            writer_putChar(writer, ']');
             first = false;
             pNode = pNode->next;
         }
-        printf("\n");
+        writer_putChar(writer, '\n');
         pDay = pDay->next;
     }
 }
+
+// Modify the doses of a certain vaccine only on its timeline. The daily list is rebuilt when it is read again
+void stockList_adjust(tVaccineStockData* list, tDate date, tVaccine* vaccine, int doses) {
+    assert(list != NULL);
+    assert(vaccine != NULL);
+    
+    list->epoch++;
+    timeline_update(stockList_getTimeline(list, vaccine, true), date_toDays(date), doses);
+    list->stale = true;
+}
+
+// Rebuild the daily list from the timelines if it is not up to date. Only needed before reading the daily list
+void stockList_sync(tVaccineStockData* list) {
+    tVaccineStockData days;
+    tStockTimeline* timelines;
+    int timelineCount;
+    tDate date;
+    int i;
+    int day;
+    int doses;
+    int previous;
+    
+    assert(list != NULL);
+    
+    if (!list->stale) {
+        return;
+    }
+    
+    // Add the changes of each timeline to an empty list
+    stockList_init(&days);
+    for (i = 0; i < list->timelineCount; i++) {
+        previous = 0;
+        for (day = list->timelines[i].firstDay; day < list->timelines[i].firstDay + list->timelines[i].size; day++) {
+            doses = timeline_getDoses(&(list->timelines[i]), day);
+            if (doses != previous) {
+                date_fromDays(&date, day);
+                stockList_update(&days, date, list->timelines[i].vaccine, doses - previous);
+                previous = doses;
+            }
+        }
+    }
+    
+    // Replace the daily list, keeping the timelines
+    timelines = list->timelines;
+    timelineCount = list->timelineCount;
+    list->timelines = NULL;
+    list->timelineCount = 0;
+    stockList_free(list);
+    list->first = days.first;
+    list->last = days.last;
+    list->count = days.count;
+    list->days = days.days;
+    list->timelines = timelines;
+    list->timelineCount = timelineCount;
+    list->stale = false;
+    
+    // Release the timelines of the temporary list
+    days.first = NULL;
+    days.last = NULL;
+    days.count = 0;
+    days.days = NULL;
+    stockList_free(&days);
+}
+
+// Get the first date not before the given one with at least the given doses of a vaccine. Return false if there is none
+bool stockList_findFirst(tVaccineStockData* list, tDate date, tVaccine* vaccine, int doses, tDate* first) {
+    tStockTimeline *pTimeline = NULL;
+    int day;
+    
+    assert(list != NULL);
+    assert(first != NULL);
+    
+    day = date_toDays(date);
+    if (doses > 0) {
+        // Without timeline there are no doses of this vaccine on any day
+        pTimeline = stockList_getTimeline(list, vaccine, false);
+        if (pTimeline == NULL) {
+            return false;
+        }
+        day = timeline_findFirst(pTimeline, day, doses);
+        if (day == TIMELINE_NOT_FOUND) {
+            return false;
+        }
+    }
+    
+    date_fromDays(first, day);
+    return true;
+}
+
+// Get the first date not before the given one where the given number of persons can receive all the doses of a vaccine. Return false if there is none
+bool stockList_findFirstSeries(tVaccineStockData* list, tDate date, tVaccine* vaccine, int persons, tDate* first) {
+    tStockTimeline *pTimeline = NULL;
+    int day;
+    int doseDay;
+    int found;
+    int count;
+    
+    assert(list != NULL);
+    assert(vaccine != NULL);
+    assert(first != NULL);
+    
+    day = date_toDays(date);
+    if (persons > 0) {
+        pTimeline = stockList_getTimeline(list, vaccine, false);
+        if (pTimeline == NULL) {
+            return false;
+        }
+        
+        // Stock is cumulative, so the dose n needs the doses of the previous ones too. When a dose fails, 
+        // the first dose moves to the first day the failing dose could be given, which skips all the days between them
+        count = 0;
+        while (count < vaccine->required) {
+            doseDay = day + count * vaccine->days;
+            found = timeline_findFirst(pTimeline, doseDay, persons * (count + 1));
+            if (found == TIMELINE_NOT_FOUND) {
+                return false;
+            }
+            if (found == doseDay) {
+                count++;
+            } else {
+                day = found - count * vaccine->days;
+                count = 0;
+            }
+        }
+    }
+    
+    date_fromDays(first, day);
+    return true;
+}
+
+// Get the timeline of a vaccine. If it does not exist and create is true it is added, otherwise NULL is returned
+tStockTimeline* stockList_getTimeline(tVaccineStockData* list, tVaccine* vaccine, bool create) {
+    int i;
+    
+    assert(list != NULL);
+    
+    for (i = 0; i < list->timelineCount; i++) {
+        if (list->timelines[i].vaccine == vaccine) {
+            return &(list->timelines[i]);
+        }
+    }
+    
+    if (!create) {
+        return NULL;
+    }
+    
+    list->timelines = (tStockTimeline*) realloc(list->timelines, (list->timelineCount + 1) * sizeof(tStockTimeline));
+    assert(list->timelines != NULL);
+    timeline_init(&(list->timelines[list->timelineCount]), vaccine);
+    list->timelineCount++;
+    
+    return &(list->timelines[list->timelineCount - 1]);
+}
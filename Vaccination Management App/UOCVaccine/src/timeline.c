@@ -0,0 +1,248 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "timeline.h"
+
+// Initialize an empty timeline for a vaccine
+void timeline_init(tStockTimeline* timeline, tVaccine* vaccine) {
+    assert(timeline != NULL);
+    
+    timeline->vaccine = vaccine;
+    timeline->firstDay = 0;
+    timeline->size = 0;
+    timeline->max = NULL;
+    timeline->add = NULL;
+}
+
+// Release the timeline data
+void timeline_free(tStockTimeline* timeline) {
+    assert(timeline != NULL);
+    
+    if (timeline->max != NULL) {
+        free(timeline->max);
+        free(timeline->add);
+    }
+    timeline->max = NULL;
+    timeline->add = NULL;
+    timeline->size = 0;
+}
+
+// Add doses to the given day and all the following ones. Days after the last leaf have the doses of the last leaf
+void timeline_update(tStockTimeline* timeline, int day, int doses) {
+    assert(timeline != NULL);
+    
+    if (timeline->size == 0 || day < timeline->firstDay || day >= timeline->firstDay + timeline->size) {
+        timeline_grow(timeline, day);
+    }
+    
+    timeline_addRange(timeline, 1, 0, timeline->size, day - timeline->firstDay, timeline->size, doses);
+}
+
+// Get the number of doses on the given day
+int timeline_getDoses(tStockTimeline* timeline, int day) {
+    int node;
+    int doses;
+    
+    assert(timeline != NULL);
+    
+    if (timeline->size == 0 || day < timeline->firstDay) {
+        return 0;
+    }
+    if (day >= timeline->firstDay + timeline->size) {
+        day = timeline->firstDay + timeline->size - 1;
+    }
+    
+    // Sum the pending additions from the leaf to the root
+    doses = 0;
+    for (node = timeline->size + day - timeline->firstDay; node >= 1; node /= 2) {
+        doses += timeline->add[node];
+    }
+    
+    return doses;
+}
+
+// Get the first day not before the given one with at least the given number of doses. TIMELINE_NOT_FOUND if there is none
+int timeline_findFirst(tStockTimeline* timeline, int day, int doses) {
+    int pos;
+    
+    assert(timeline != NULL);
+    
+    if (doses <= 0) {
+        return day;
+    }
+    if (timeline->size == 0) {
+        return TIMELINE_NOT_FOUND;
+    }
+    
+    // Days after the last leaf have its doses
+    if (day >= timeline->firstDay + timeline->size) {
+        return timeline_getDoses(timeline, day) >= doses ? day : TIMELINE_NOT_FOUND;
+    }
+    
+    // Days before the first leaf have no doses
+    if (day < timeline->firstDay) {
+        day = timeline->firstDay;
+    }
+    
+    pos = timeline_descend(timeline, 1, 0, timeline->size, day - timeline->firstDay, doses, 0);
+    if (pos < 0) {
+        return TIMELINE_NOT_FOUND;
+    }
+    
+    return timeline->firstDay + pos;
+}
+
+// Store on doses the number of doses of the given count of days from the given one
+void timeline_getRange(tStockTimeline* timeline, int day, int count, int* doses) {
+    int start;
+    int end;
+    int i;
+    
+    assert(timeline != NULL);
+    assert(count >= 0);
+    assert(doses != NULL);
+    
+    if (timeline->size == 0) {
+        memset(doses, 0, count * sizeof(int));
+        return;
+    }
+    
+    // Days before the first leaf have no doses
+    for (i = 0; i < count && day + i < timeline->firstDay; i++) {
+        doses[i] = 0;
+    }
+    
+    // Leaves of the range are read on a single traversal
+    start = day + i - timeline->firstDay;
+    end = day + count - timeline->firstDay;
+    if (end > timeline->size) {
+        end = timeline->size;
+    }
+    if (start < end) {
+        timeline_collect(timeline, 1, 0, timeline->size, start, end, 0, doses + i);
+        i += end - start;
+    }
+    
+    // Days after the last leaf have its doses
+    for (; i < count; i++) {
+        doses[i] = timeline_getDoses(timeline, day + i);
+    }
+}
+
+// [AUX METHOD] Add doses to the days of the node on the range [start, end)
+void timeline_addRange(tStockTimeline* timeline, int node, int nodeStart, int nodeEnd, int start, int end, int doses) {
+    int mid;
+    
+    if (end <= nodeStart || nodeEnd <= start) {
+        return;
+    }
+    
+    // The whole node is updated, keep the addition pending for its children
+    if (start <= nodeStart && nodeEnd <= end) {
+        timeline->add[node] += doses;
+        timeline->max[node] += doses;
+        return;
+    }
+    
+    mid = (nodeStart + nodeEnd) / 2;
+    timeline_addRange(timeline, 2 * node, nodeStart, mid, start, end, doses);
+    timeline_addRange(timeline, 2 * node + 1, mid, nodeEnd, start, end, doses);
+    timeline->max[node] = timeline->add[node] + (timeline->max[2 * node] > timeline->max[2 * node + 1] ? timeline->max[2 * node] : timeline->max[2 * node + 1]);
+}
+
+// [AUX METHOD] Search the first leaf from the given position with at least the given number of doses
+int timeline_descend(tStockTimeline* timeline, int node, int nodeStart, int nodeEnd, int from, int doses, int pending) {
+    int mid;
+    int pos;
+    
+    // Skip nodes before the position or without enough doses on any day
+    if (nodeEnd <= from || pending + timeline->max[node] < doses) {
+        return -1;
+    }
+    if (nodeEnd - nodeStart == 1) {
+        return nodeStart;
+    }
+    
+    pending += timeline->add[node];
+    mid = (nodeStart + nodeEnd) / 2;
+    pos = timeline_descend(timeline, 2 * node, nodeStart, mid, from, doses, pending);
+    if (pos < 0) {
+        pos = timeline_descend(timeline, 2 * node + 1, mid, nodeEnd, from, doses, pending);
+    }
+    
+    return pos;
+}
+
+// [AUX METHOD] Store on doses the number of doses of the leaves of the node on the range [start, end), from the position of start
+void timeline_collect(tStockTimeline* timeline, int node, int nodeStart, int nodeEnd, int start, int end, int pending, int* doses) {
+    int mid;
+    
+    if (end <= nodeStart || nodeEnd <= start) {
+        return;
+    }
+    
+    pending += timeline->add[node];
+    if (nodeEnd - nodeStart == 1) {
+        doses[nodeStart - start] = pending;
+        return;
+    }
+    
+    mid = (nodeStart + nodeEnd) / 2;
+    timeline_collect(timeline, 2 * node, nodeStart, mid, start, end, pending, doses);
+    timeline_collect(timeline, 2 * node + 1, mid, nodeEnd, start, end, pending, doses);
+}
+
+// [AUX METHOD] Grow the timeline to include the given day
+void timeline_grow(tStockTimeline* timeline, int day) {
+    int* values;
+    int size;
+    int firstDay;
+    int end;
+    int i;
+    
+    assert(timeline != NULL);
+    
+    // Double the size until the day fits. When growing to the left, the new days are placed before the current ones
+    if (timeline->size == 0) {
+        size = TIMELINE_INITIAL_DAYS;
+        firstDay = day;
+    } else {
+        end = timeline->firstDay + timeline->size;
+        if (day + 1 > end) {
+            end = day + 1;
+        }
+        size = timeline->size * 2;
+        while (size < end - (day < timeline->firstDay ? day : timeline->firstDay)) {
+            size *= 2;
+        }
+        firstDay = day < timeline->firstDay ? end - size : timeline->firstDay;
+    }
+    
+    // Doses of each day with the current tree
+    values = (int*) malloc(size * sizeof(int));
+    assert(values != NULL);
+    for (i = 0; i < size; i++) {
+        values[i] = timeline_getDoses(timeline, firstDay + i);
+    }
+    
+    // Create the new tree with the doses on the leaves
+    timeline_free(timeline);
+    timeline->max = (int*) malloc(2 * size * sizeof(int));
+    timeline->add = (int*) malloc(2 * size * sizeof(int));
+    assert(timeline->max != NULL);
+    assert(timeline->add != NULL);
+    timeline->size = size;
+    timeline->firstDay = firstDay;
+    for (i = 0; i < size; i++) {
+        timeline->add[size + i] = values[i];
+        timeline->max[size + i] = values[i];
+    }
+    for (i = size - 1; i >= 1; i--) {
+        timeline->add[i] = 0;
+        timeline->max[i] = timeline->max[2 * i] > timeline->max[2 * i + 1] ? timeline->max[2 * i] : timeline->max[2 * i + 1];
+    }
+    timeline->add[0] = 0;
+    timeline->max[0] = 0;
+    
+    free(values);
+}
@@ -41,17 +41,26 @@ void vaccine_cpy(tVaccine* destination, tVaccine source) {
 
 // Release vaccine lot data
 void vaccineLot_init(tVaccineLot* lot, tVaccine* vaccine, const char* cp, tDateTime timestamp, int doses) {
+    // Allocate the cp with malloc
+    vaccineLot_initArena(lot, vaccine, cp, timestamp, doses, NULL, NULL);
+}
+
+// Initialize a vaccine lot storing the cp on the arena. If arena is NULL the cp is allocated with malloc. If cps is not NULL, the cp refers to the interned one
+void vaccineLot_initArena(tVaccineLot* lot, tVaccine* vaccine, const char* cp, tDateTime timestamp, int doses, tStringArena* arena, tPostalCodeTable* cps) {
     assert(lot != NULL);
     assert(cp != NULL);
     
-    // Allocate memory for the cp
-    lot->cp = (char*) malloc(strlen(cp) + 1);
-    assert(lot->cp != NULL);
-    
     // Set the data
-    strcpy(lot->cp, cp);
+    if (cps != NULL) {
+        lot->cpId = postalCodeTable_intern(cps, cp);
+        lot->cp = (char*) postalCodeTable_get(cps, lot->cpId);
+    } else {
+        lot->cpId = POSTAL_CODE_UNKNOWN;
+        lot->cp = stringArena_strdup(arena, cp);
+    }
     lot->vaccine = vaccine;
     lot->timestamp = timestamp;
+    lot->key = dateTime_toKey(timestamp);
     lot->doses = doses;
 }
 
@@ -74,38 +83,53 @@ void vaccineLot_cpy(tVaccineLot* destination, tVaccineLot source) {
     vaccineLot_init(destination, source.vaccine, source.cp, source.timestamp, source.doses);
 }
 
-// Parse input from CSVEntry
-void vaccineLot_parse(tVaccine* vaccine, tVaccineLot* lot, tCSVEntry entry) {
-    char date[11];
-    char time[6];
-    char buffer[512];
-    tDateTime timestamp;
-    int doses;
-    int required;
-    int days;
+// Parse input from CSVEntry. Return false if the entry is malformed
+bool vaccineLot_parse(tVaccine* vaccine, tVaccineLot* lot, tCSVEntry entry) {
+    tVaccine vaccineView;
+    tVaccineLot lotView;
     
     // Check input data
     assert(vaccine != NULL);
     assert(lot != NULL);
     assert(csv_numFields(entry) == 7);
         
-    // Get Lot data
-    csv_getAsString(entry, 0, date, 11);    
-    csv_getAsString(entry, 1, time, 6);
-    dateTime_parse(&timestamp, date, time);
-    csv_getAsString(entry, 2, buffer, 511);
-    doses = csv_getAsInteger(entry, 6);
+    // Validate all the values before allocating any data
+    if (!vaccineLot_parseView(&vaccineView, &lotView, entry.fields)) {
+        return false;
+    }
     
     // Initialize the lot structure
-    vaccineLot_init(lot, NULL, buffer, timestamp, doses);
-                
-    // Get vaccine data    
-    csv_getAsString(entry, 3, buffer, 511);
-    required = csv_getAsInteger(entry, 4);
-    days = csv_getAsInteger(entry, 5);
+    vaccineLot_init(lot, NULL, lotView.cp, lotView.timestamp, lotView.doses);
     
     // Initialize the vaccine data
-    vaccine_init(vaccine, buffer, required, days);
+    vaccine_cpy(vaccine, vaccineView);
+    
+    return true;
+}
+
+// Parse the 7 fields of a lot without copying them. Vaccine and lot refer to the fields and must not be released
+bool vaccineLot_parseView(tVaccine* vaccine, tVaccineLot* lot, char** fields) {
+    // Check input data
+    assert(vaccine != NULL);
+    assert(lot != NULL);
+    assert(fields != NULL);
+    
+    // Parse the numeric values
+    if (!dateTime_parse(&(lot->timestamp), fields[0], fields[1]) ||
+        !csv_parseInteger(fields[4], &(vaccine->required)) ||
+        !csv_parseInteger(fields[5], &(vaccine->days)) ||
+        !csv_parseInteger(fields[6], &(lot->doses))) {
+        return false;
+    }
+    lot->key = dateTime_toKey(lot->timestamp);
+    
+    // Refer to the text fields
+    lot->cp = fields[2];
+    lot->cpId = POSTAL_CODE_UNKNOWN;
+    lot->vaccine = NULL;
+    vaccine->name = fields[3];
+    
+    return true;
 }
 
 
@@ -238,6 +262,21 @@ void vaccineList_del(tVaccineList* list, const char* vaccine) {
     }
 }
 
+// Call the visitor for each vaccine, in list order. Return the number of visited vaccines
+int vaccineList_visit(tVaccineList list, tVaccineVisitor visitor, void* context) {
+    tVaccineNode *pNode = NULL;
+    int count = 0;
+    
+    assert(visitor != NULL);
+    
+    for (pNode = list.first; pNode != NULL; pNode = pNode->next) {
+        visitor(&(pNode->vaccine), context);
+        count++;
+    }
+    
+    return count;
+}
+
 
 // Initialize the vaccine lots data
 void vaccineLotData_init(tVaccineLotData* data) {
@@ -246,18 +285,30 @@ void vaccineLotData_init(tVaccineLotData* data) {
     // Set the initial number of elements to zero.
     data->count = 0;    
     data->elems = NULL;
+    data->arena = NULL;
+    data->cps = NULL;
 }
 
 // Remove all elements
 void vaccineLotData_free(tVaccineLotData* data) {
     int i;
+    tStringArena* arena;
+    tPostalCodeTable* cps;
+    
+    arena = data->arena;
+    cps = data->cps;
     if (data->elems != NULL) {
-        for(i=0; i < data->count; i++) {
-            vaccineLot_free(&(data->elems[i]));
+        // Cps stored on the arena or interned are released with them
+        if (arena == NULL && cps == NULL) {
+            for(i=0; i < data->count; i++) {
+                vaccineLot_free(&(data->elems[i]));
+            }
         }
         free(data->elems);
     }
     vaccineLotData_init(data);    
+    data->arena = arena;
+    data->cps = cps;
 }
 
 // Get the number of lots
@@ -284,7 +335,7 @@ void vaccineLotData_add(tVaccineLotData* data, tVaccineLot lot) {
             data->elems = (tVaccineLot*) realloc(data->elems, (data->count + 1) * sizeof(tVaccineLot));
         }
         assert(data->elems != NULL);        
-        vaccineLot_cpy(&(data->elems[data->count]), lot);
+        vaccineLot_initArena(&(data->elems[data->count]), lot.vaccine, lot.cp, lot.timestamp, lot.doses, data->arena, data->cps);
         data->count ++;        
     } else {
         data->elems[idx].doses += lot.doses;
@@ -307,16 +358,16 @@ void vaccineLotData_del(tVaccineLotData* data, const char* cp, const char* vacci
         data->elems[idx].doses -= doses;
         // Shift elements to remove selected
         if (data->elems[idx].doses <= 0) {
+            // Remove the data from this position. Cps stored on the arena or interned are kept until they are released
+            if (data->arena == NULL && data->cps == NULL) {
+                vaccineLot_free(&(data->elems[idx]));
+            }
             for(i = idx; i < data->count-1; i++) {
-                // Remove the data from this position
-                vaccineLot_free(&(data->elems[i]));
-                // Copy element on position i+1 to position i
-                vaccineLot_cpy(&(data->elems[i]), data->elems[i+1]);
+                // Move element on position i+1 to position i
+                data->elems[i] = data->elems[i+1];
             }            
             // Update the number of elements
             data->count--;     
-            // Free last position
-            vaccineLot_free(&(data->elems[data->count]));
         }        
         if (data->count > 0) {
             data->elems = (tVaccineLot*) realloc(data->elems, data->count * sizeof(tVaccineLot));
@@ -331,12 +382,28 @@ void vaccineLotData_del(tVaccineLotData* data, const char* cp, const char* vacci
 // Return the position of a vaccine lot entry with provided information. -1 if it does not exist
 int vaccineLotData_find(tVaccineLotData data, const char* cp, const char* vaccine, tDateTime timestamp) {
     int i;
+    int cpId;
+    tDateTimeKey key;
     
     assert(cp != NULL);
     assert(vaccine != NULL);    
     
+    // Compare the packed timestamp before the strings
+    key = dateTime_toKey(timestamp);
+    
+    // With interned cps, compare the identifiers
+    if (data.cps != NULL) {
+        cpId = postalCodeTable_find(data.cps, cp);
+        for(i = 0; i < data.count && cpId != POSTAL_CODE_UNKNOWN; i++) {
+            if(data.elems[i].key == key && data.elems[i].cpId == cpId && strcmp(data.elems[i].vaccine->name, vaccine) == 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+    
     for(i = 0; i < data.count; i++) {
-        if(strcmp(data.elems[i].cp, cp) == 0 && strcmp(data.elems[i].vaccine->name, vaccine) == 0 && dateTime_equals(data.elems[i].timestamp, timestamp)) {
+        if(data.elems[i].key == key && strcmp(data.elems[i].cp, cp) == 0 && strcmp(data.elems[i].vaccine->name, vaccine) == 0) {
             return i;
         }
     }
@@ -344,3 +411,15 @@ int vaccineLotData_find(tVaccineLotData data, const char* cp, const char* vaccin
     return -1;
 }
 
+// Call the visitor for each vaccine lot, in table order. Return the number of visited lots
+int vaccineLotData_visit(tVaccineLotData data, tVaccineLotVisitor visitor, void* context) {
+    int i;
+    
+    assert(visitor != NULL);
+    
+    for (i = 0; i < data.count; i++) {
+        visitor(&(data.elems[i]), context);
+    }
+    
+    return data.count;
+}
@@ -0,0 +1,147 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "waitlist.h"
+
+// Initialize an empty waitlist
+void waitlist_init(tWaitlist* list) {
+    assert(list != NULL);
+    
+    list->elems = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+// Release the waitlist data
+void waitlist_free(tWaitlist* list) {
+    assert(list != NULL);
+    
+    if (list->elems != NULL) {
+        free(list->elems);
+    }
+    list->elems = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+// Add the request of the person on the given position, with its birthday
+void waitlist_push(tWaitlist* list, int person, tDate birthday, tDateTime timestamp) {
+    tWaitlistEntry* pEntry;
+    
+    assert(list != NULL);
+    assert(person >= 0);
+    
+    // Double the allocated entries when it is full
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity == 0 ? 8 : list->capacity * 2;
+        list->elems = (tWaitlistEntry*) realloc(list->elems, list->capacity * sizeof(tWaitlistEntry));
+        assert(list->elems != NULL);
+    }
+    
+    pEntry = &(list->elems[list->count]);
+    pEntry->person = person;
+    pEntry->birthday = date_toDays(birthday);
+    pEntry->timestamp = timestamp;
+    pEntry->key = dateTime_toKey(timestamp);
+    list->count++;
+    
+    waitlist_siftUp(list, list->count - 1);
+}
+
+// Remove the request with the highest priority. Return false if the waitlist is empty
+bool waitlist_pop(tWaitlist* list, tWaitlistEntry* entry) {
+    assert(list != NULL);
+    assert(entry != NULL);
+    
+    if (list->count == 0) {
+        return false;
+    }
+    
+    *entry = list->elems[0];
+    list->count--;
+    if (list->count > 0) {
+        list->elems[0] = list->elems[list->count];
+        waitlist_siftDown(list, 0);
+    }
+    
+    return true;
+}
+
+// Remove the requests of the person on the given position after it is removed from the population. The next persons move one position down
+void waitlist_delPerson(tWaitlist* list, int person) {
+    int i;
+    int count;
+    
+    assert(list != NULL);
+    assert(person >= 0);
+    
+    // Keep the other requests. Positions do not change their priority
+    count = 0;
+    for (i = 0; i < list->count; i++) {
+        if (list->elems[i].person != person) {
+            list->elems[count] = list->elems[i];
+            if (list->elems[count].person > person) {
+                list->elems[count].person--;
+            }
+            count++;
+        }
+    }
+    
+    // Build the heap again if some request was removed
+    if (count < list->count) {
+        list->count = count;
+        for (i = count / 2 - 1; i >= 0; i--) {
+            waitlist_siftDown(list, i);
+        }
+    }
+}
+
+// Get the number of requests
+int waitlist_len(tWaitlist list) {
+    return list.count;
+}
+
+// [AUX METHOD] Check if the first entry has higher priority than the second one
+bool waitlist_before(tWaitlistEntry* a, tWaitlistEntry* b) {
+    if (a->birthday != b->birthday) {
+        return a->birthday < b->birthday;
+    }
+    return a->key < b->key;
+}
+
+// [AUX METHOD] Move the entry on the given position up to its place
+void waitlist_siftUp(tWaitlist* list, int pos) {
+    tWaitlistEntry entry;
+    int parent;
+    
+    entry = list->elems[pos];
+    while (pos > 0) {
+        parent = (pos - 1) / 2;
+        if (!waitlist_before(&entry, &(list->elems[parent]))) {
+            break;
+        }
+        list->elems[pos] = list->elems[parent];
+        pos = parent;
+    }
+    list->elems[pos] = entry;
+}
+
+// [AUX METHOD] Move the entry on the given position down to its place
+void waitlist_siftDown(tWaitlist* list, int pos) {
+    tWaitlistEntry entry;
+    int child;
+    
+    entry = list->elems[pos];
+    while (2 * pos + 1 < list->count) {
+        // Select the child with the highest priority
+        child = 2 * pos + 1;
+        if (child + 1 < list->count && waitlist_before(&(list->elems[child + 1]), &(list->elems[child]))) {
+            child++;
+        }
+        if (!waitlist_before(&(list->elems[child]), &entry)) {
+            break;
+        }
+        list->elems[pos] = list->elems[child];
+        pos = child;
+    }
+    list->elems[pos] = entry;
+}
@@ -0,0 +1,297 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "writer.h"
+
+// Initialize a writer to a file
+void writer_initFile(tReportWriter* writer, FILE* file, tReportFormat format) {
+    assert(writer != NULL);
+    assert(file != NULL);
+    
+    writer->buffer = (char*) malloc(WRITER_BUFFER_SIZE);
+    assert(writer->buffer != NULL);
+    writer->length = 0;
+    writer->file = file;
+    writer->fd = -1;
+    writer->format = format;
+    writer->fields = 0;
+    writer->error = false;
+}
+
+// Initialize a writer to a file descriptor
+void writer_initFd(tReportWriter* writer, int fd, tReportFormat format) {
+    assert(writer != NULL);
+    assert(fd >= 0);
+    
+    writer->buffer = (char*) malloc(WRITER_BUFFER_SIZE);
+    assert(writer->buffer != NULL);
+    writer->length = 0;
+    writer->file = NULL;
+    writer->fd = fd;
+    writer->format = format;
+    writer->fields = 0;
+    writer->error = false;
+}
+
+// Write the buffered data to the target. Return false if some write failed
+bool writer_flush(tReportWriter* writer) {
+    ssize_t written;
+    int pos;
+    
+    assert(writer != NULL);
+    
+    if (writer->length > 0 && !writer->error) {
+        if (writer->file != NULL) {
+            if (fwrite(writer->buffer, 1, writer->length, writer->file) != (size_t) writer->length) {
+                writer->error = true;
+            }
+        } else {
+            // Writes to a descriptor can be partial
+            pos = 0;
+            while (pos < writer->length && !writer->error) {
+                written = write(writer->fd, writer->buffer + pos, writer->length - pos);
+                if (written <= 0) {
+                    writer->error = true;
+                } else {
+                    pos += (int) written;
+                }
+            }
+        }
+    }
+    writer->length = 0;
+    
+    return !writer->error;
+}
+
+// Flush the buffered data and release the writer. The target is not closed
+void writer_free(tReportWriter* writer) {
+    assert(writer != NULL);
+    
+    if (writer->buffer != NULL) {
+        writer_flush(writer);
+        free(writer->buffer);
+    }
+    writer->buffer = NULL;
+    writer->length = 0;
+    writer->file = NULL;
+    writer->fd = -1;
+}
+
+// Add a character
+void writer_putChar(tReportWriter* writer, char c) {
+    assert(writer != NULL);
+    assert(writer->buffer != NULL);
+    
+    if (writer->length == WRITER_BUFFER_SIZE) {
+        writer_flush(writer);
+    }
+    writer->buffer[writer->length++] = c;
+}
+
+// Add a string. NULL strings are empty
+void writer_putStr(tReportWriter* writer, const char* str) {
+    if (str != NULL) {
+        writer_putBytes(writer, str, (int) strlen(str));
+    }
+}
+
+// Add an integer
+void writer_putInt(tReportWriter* writer, int value) {
+    char digits[12];
+    unsigned int magnitude;
+    int pos;
+    
+    // The magnitude of the minimum integer does not fit on an int
+    magnitude = value < 0 ? 0u - (unsigned int) value : (unsigned int) value;
+    
+    // Digits are generated from the last one
+    pos = sizeof(digits);
+    do {
+        digits[--pos] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        digits[--pos] = '-';
+    }
+    
+    writer_putBytes(writer, digits + pos, sizeof(digits) - pos);
+}
+
+// Add a non negative integer with leading zeros up to the given width
+void writer_putIntPad(tReportWriter* writer, int value, int width) {
+    char digits[12];
+    int pos;
+    
+    assert(value >= 0);
+    assert(width <= (int) sizeof(digits));
+    
+    pos = sizeof(digits);
+    do {
+        digits[--pos] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while ((int) sizeof(digits) - pos < width) {
+        digits[--pos] = '0';
+    }
+    
+    writer_putBytes(writer, digits + pos, sizeof(digits) - pos);
+}
+
+// Add a date with the format dd/mm/yyyy
+void writer_putDate(tReportWriter* writer, tDate date) {
+    writer_putIntPad(writer, date.day, 2);
+    writer_putChar(writer, '/');
+    writer_putIntPad(writer, date.month, 2);
+    writer_putChar(writer, '/');
+    writer_putIntPad(writer, date.year, 4);
+}
+
+// Add a time with the format hh:mm
+void writer_putTime(tReportWriter* writer, tTime time) {
+    writer_putIntPad(writer, time.hour, 2);
+    writer_putChar(writer, ':');
+    writer_putIntPad(writer, time.minutes, 2);
+}
+
+// Start a record of the given type
+void writer_beginRecord(tReportWriter* writer, const char* type) {
+    assert(writer != NULL);
+    assert(type != NULL);
+    
+    if (writer->format == REPORT_JSON) {
+        writer_putStr(writer, "{\"type\":\"");
+        writer_putJsonStr(writer, type);
+        writer_putChar(writer, '"');
+    } else {
+        writer_putStr(writer, type);
+    }
+    writer->fields = 1;
+}
+
+// Add a text field to the current record
+void writer_fieldStr(tReportWriter* writer, const char* name, const char* value) {
+    writer_beginField(writer, name);
+    if (writer->format == REPORT_JSON) {
+        writer_putChar(writer, '"');
+        writer_putJsonStr(writer, value);
+        writer_putChar(writer, '"');
+    } else {
+        writer_putStr(writer, value);
+    }
+}
+
+// Add an integer field to the current record
+void writer_fieldInt(tReportWriter* writer, const char* name, int value) {
+    writer_beginField(writer, name);
+    writer_putInt(writer, value);
+}
+
+// Add a date field to the current record
+void writer_fieldDate(tReportWriter* writer, const char* name, tDate value) {
+    writer_beginField(writer, name);
+    if (writer->format == REPORT_JSON) {
+        writer_putChar(writer, '"');
+        writer_putDate(writer, value);
+        writer_putChar(writer, '"');
+    } else {
+        writer_putDate(writer, value);
+    }
+}
+
+// Add a time field to the current record
+void writer_fieldTime(tReportWriter* writer, const char* name, tTime value) {
+    writer_beginField(writer, name);
+    if (writer->format == REPORT_JSON) {
+        writer_putChar(writer, '"');
+        writer_putTime(writer, value);
+        writer_putChar(writer, '"');
+    } else {
+        writer_putTime(writer, value);
+    }
+}
+
+// End the current record
+void writer_endRecord(tReportWriter* writer) {
+    assert(writer != NULL);
+    
+    if (writer->format == REPORT_JSON) {
+        writer_putChar(writer, '}');
+    }
+    writer_putChar(writer, '\n');
+    writer->fields = 0;
+}
+
+// [AUX METHOD] Add the given number of bytes
+void writer_putBytes(tReportWriter* writer, const char* bytes, int length) {
+    int size;
+    
+    assert(writer != NULL);
+    assert(writer->buffer != NULL);
+    assert(bytes != NULL || length == 0);
+    
+    while (length > 0) {
+        if (writer->length == WRITER_BUFFER_SIZE) {
+            writer_flush(writer);
+        }
+        size = WRITER_BUFFER_SIZE - writer->length;
+        if (size > length) {
+            size = length;
+        }
+        memcpy(writer->buffer + writer->length, bytes, size);
+        writer->length += size;
+        bytes += size;
+        length -= size;
+    }
+}
+
+// [AUX METHOD] Start a field of the current record, adding its separator and name
+void writer_beginField(tReportWriter* writer, const char* name) {
+    assert(writer != NULL);
+    assert(name != NULL);
+    
+    if (writer->format == REPORT_JSON) {
+        writer_putStr(writer, writer->fields > 0 ? ",\"" : "{\"");
+        writer_putJsonStr(writer, name);
+        writer_putStr(writer, "\":");
+    } else if (writer->fields > 0) {
+        writer_putChar(writer, ';');
+    }
+    writer->fields++;
+}
+
+// [AUX METHOD] Add a string escaped as the content of a JSON string
+void writer_putJsonStr(tReportWriter* writer, const char* str) {
+    static const char hex[] = "0123456789abcdef";
+    const char *pStart;
+    unsigned char c;
+    
+    if (str == NULL) {
+        return;
+    }
+    
+    // Copy the runs of characters that do not need escapes at once
+    pStart = str;
+    for (; *str != '\0'; str++) {
+        c = (unsigned char) *str;
+        if (c == '"' || c == '\\' || c < 0x20) {
+            writer_putBytes(writer, pStart, (int) (str - pStart));
+            writer_putChar(writer, '\\');
+            if (c == '"' || c == '\\') {
+                writer_putChar(writer, (char) c);
+            } else if (c == '\n') {
+                writer_putChar(writer, 'n');
+            } else if (c == '\t') {
+                writer_putChar(writer, 't');
+            } else if (c == '\r') {
+                writer_putChar(writer, 'r');
+            } else {
+                writer_putStr(writer, "u00");
+                writer_putChar(writer, hex[c >> 4]);
+                writer_putChar(writer, hex[c & 0x0F]);
+            }
+            pStart = str + 1;
+        }
+    }
+    writer_putBytes(writer, pStart, (int) (str - pStart));
+}
@@ -0,0 +1,86 @@
+#ifndef __TEST_PR4_H__
+#define __TEST_PR4_H__
+
+#include <stdbool.h>
+#include "test_suite.h"
+
+// Run all tests for PR4
+bool run_pr4(tTestSuite* test_suite, const char* input);
+
+// Run tests for PR4 exercice 1
+bool run_pr4_ex1(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 2
+bool run_pr4_ex2(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 3
+bool run_pr4_ex3(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 4
+bool run_pr4_ex4(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 5
+bool run_pr4_ex5(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 6
+bool run_pr4_ex6(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 7
+bool run_pr4_ex7(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 8
+bool run_pr4_ex8(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 9
+bool run_pr4_ex9(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 10
+bool run_pr4_ex10(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 11
+bool run_pr4_ex11(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 12
+bool run_pr4_ex12(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 13
+bool run_pr4_ex13(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 14
+bool run_pr4_ex14(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 15
+bool run_pr4_ex15(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 16
+bool run_pr4_ex16(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 17
+bool run_pr4_ex17(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 18
+bool run_pr4_ex18(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 19
+bool run_pr4_ex19(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 20
+bool run_pr4_ex20(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 21
+bool run_pr4_ex21(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 22
+bool run_pr4_ex22(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 23
+bool run_pr4_ex23(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 24
+bool run_pr4_ex24(tTestSection* test_section, const char* input);
+
+// Run tests for PR4 exercice 25
+bool run_pr4_ex25(tTestSection* test_section, const char* input);
+
+
+#endif // __TEST_PR4_H__
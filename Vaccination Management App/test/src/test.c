@@ -5,6 +5,7 @@
 #include "test_pr1.h"
 #include "test_pr2.h"
 #include "test_pr3.h"
+#include "test_pr4.h"
 
 
 // Write data to file
@@ -72,4 +73,18 @@ void testSuite_run(tTestSuite* test_suite, const char* input, const char* readme
     }
     // Run tests
     run_pr3(test_suite, filename);
+    
+    //////////////////////
+    // Run tests for PR4
+    //////////////////////
+    
+    // If no file is provided, use default data for PR4, the same data of PR3
+    if (input == NULL) {
+        filename = "test_data_pr3.csv";
+        save_data(filename, test_data_pr3_str);        
+    } else {
+        filename = input;
+    }
+    // Run tests
+    run_pr4(test_suite, filename);
 }
@@ -26,6 +26,7 @@ bool run_pr3(tTestSuite* test_suite, const char* input) {
 // Run all tests for Exercice 1 of PR3
 bool run_pr3_ex1(tTestSection* test_section, const char* input) {            
     tPerson person1, person2;
+    tPersonContact contact1, contact2;
     tVaccine vModerna, vPfizer;
     tCSVEntry entry;
     tAppointmentData data;
@@ -39,14 +40,16 @@ bool run_pr3_ex1(tTestSection* test_section, const char* input) {
     // Initialize sample persons
     csv_initEntry(&entry);
     person_init(&person1);
+    personContact_init(&contact1);
     csv_parseEntry(&entry, "87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980", "PERSON");
-    person_parse(&person1, entry);
+    person_parse(&person1, &contact1, entry);
     csv_freeEntry(&entry);    
         
     csv_initEntry(&entry);    
     person_init(&person2);
+    personContact_init(&contact2);
     csv_parseEntry(&entry, "98765432J;Jane;Doe;jane.doe@example.com;Her street, 5;08500;12/01/1995", "PERSON");
-    person_parse(&person2, entry);
+    person_parse(&person2, &contact2, entry);
     csv_freeEntry(&entry);
         
     // Initialize sample vaccines
@@ -227,6 +230,8 @@ bool run_pr3_ex1(tTestSection* test_section, const char* input) {
     
     // Release appointment data
     appointmentData_free(&data);
+    personContact_free(&contact1);
+    personContact_free(&contact2);
     
     return passed;
 }
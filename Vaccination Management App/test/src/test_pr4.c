@@ -0,0 +1,3140 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include "test_pr4.h"
+#include "api.h"
+
+// Number of calls to the test entry handler
+int test_pr4_handled = 0;
+
+// Test handler for CENTER entries
+tApiError test_pr4_addCenter(tApiData* data, char** fields, int numFields) {
+    if (numFields != 1) {
+        return E_INVALID_ENTRY_FORMAT;
+    }
+    centerList_insert(&(data->centers), fields[0]);
+    test_pr4_handled++;
+    return E_SUCCESS;
+}
+
+// Keep the last visited person
+void test_pr4_lastPerson(tPerson* person, void* context) {
+    tPerson **pLast = (tPerson**) context;
+    *pLast = person;
+}
+
+// Append the document of the visited person to a string
+void test_pr4_appendDocument(tPerson* person, void* context) {
+    char *str = (char*) context;
+    strcat(str, person->document);
+    strcat(str, ";");
+}
+
+// Add the visited values
+void test_pr4_sumValues(uint32_t value, void* context) {
+    uint64_t *pSum = (uint64_t*) context;
+    *pSum += value;
+}
+
+// Append the name of the visited vaccine to a string
+void test_pr4_appendVaccine(const tVaccine* vaccine, void* context) {
+    char *str = (char*) context;
+    strcat(str, vaccine->name);
+    strcat(str, ";");
+}
+
+// Add the doses of the visited lot
+void test_pr4_sumLotDoses(const tVaccineLot* lot, void* context) {
+    int *pSum = (int*) context;
+    *pSum += lot->doses;
+}
+
+// Append the date, cp and vaccine of the visited appointment to a string
+void test_pr4_appendAppointment(const tAppointment* appointment, const char* cp, void* context) {
+    char *str = (char*) context;
+    sprintf(str + strlen(str), "%02d/%02d/%04d %s %s;", appointment->timestamp.date.day, appointment->timestamp.date.month, 
+        appointment->timestamp.date.year, cp, appointment->vaccine->name);
+}
+
+// Run all tests for PR4
+bool run_pr4(tTestSuite* test_suite, const char* input) {
+    bool ok = true;
+    tTestSection* section = NULL;
+
+    assert(test_suite != NULL);
+
+    testSuite_addSection(test_suite, "PR4", "Tests for PR4 exercices");
+
+    section = testSuite_getSection(test_suite, "PR4");
+    assert(section != NULL);
+
+    ok = run_pr4_ex1(section, input);
+    ok = run_pr4_ex2(section, input) && ok;
+    ok = run_pr4_ex3(section, input) && ok;
+    ok = run_pr4_ex4(section, input) && ok;
+    ok = run_pr4_ex5(section, input) && ok;
+    ok = run_pr4_ex6(section, input) && ok;
+    ok = run_pr4_ex7(section, input) && ok;
+    ok = run_pr4_ex8(section, input) && ok;
+    ok = run_pr4_ex9(section, input) && ok;
+    ok = run_pr4_ex10(section, input) && ok;
+    ok = run_pr4_ex11(section, input) && ok;
+    ok = run_pr4_ex12(section, input) && ok;
+    ok = run_pr4_ex13(section, input) && ok;
+    ok = run_pr4_ex14(section, input) && ok;
+    ok = run_pr4_ex15(section, input) && ok;
+    ok = run_pr4_ex16(section, input) && ok;
+    ok = run_pr4_ex17(section, input) && ok;
+    ok = run_pr4_ex18(section, input) && ok;
+    ok = run_pr4_ex19(section, input) && ok;
+    ok = run_pr4_ex20(section, input) && ok;
+    ok = run_pr4_ex21(section, input) && ok;
+    ok = run_pr4_ex22(section, input) && ok;
+    ok = run_pr4_ex23(section, input) && ok;
+    ok = run_pr4_ex24(section, input) && ok;
+    ok = run_pr4_ex25(section, input) && ok;
+
+    return ok;
+}
+
+// Run all tests for Exercice 1 of PR4
+bool run_pr4_ex1(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tCSVEntry entry;
+    tDate date;
+    int hits, misses;
+    bool available;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        failed = true;
+        fail_all = true;
+    } 
+    
+    // Load the test data    
+    if (!fail_all) {
+        error = api_loadData(&data, input, true);
+        if (error != E_SUCCESS) {        
+            passed = false; 
+            failed = true;
+            fail_all = true;
+        }        
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX1 TEST 1  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX1_1", "Availability cache is empty after loading data");
+    if (!fail_all) {
+        api_getAvailabilityCacheStats(data, &hits, &misses);
+        if (hits != 0 || misses != 0) {
+            failed = true;
+            fail_all = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX1_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX1 TEST 2  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX1_2", "Repeated availability check is served from the cache");
+    if (!fail_all) {
+        date_parse(&date, "01/04/2022");
+        available = api_checkAvailability(data, "08001", "PFIZER", date);
+        if (api_checkAvailability(data, "08001", "PFIZER", date) != available || !available) {
+            failed = true;
+            fail_all = true;
+            passed = false;
+        } else {
+            api_getAvailabilityCacheStats(data, &hits, &misses);
+            if (hits != 1 || misses != 1) {
+                failed = true;
+                fail_all = true;
+                passed = false;
+            }
+        }
+    }
+    end_test(test_section, "PR4_EX1_2", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX1 TEST 3  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX1_3", "Stock changes invalidate cached answers");
+    if (!fail_all) {
+        date_parse(&date, "01/04/2022");
+        if (api_checkAvailability(data, "08001", "MODERNA", date)) {
+            failed = true;
+            fail_all = true;
+            passed = false;
+        } else {
+            csv_initEntry(&entry);
+            csv_parseEntry(&entry, "01/04/2022;09:00;08001;MODERNA;1;0;5", "VACCINE_LOT");
+            error = api_addVaccineLot(&data, entry);
+            csv_freeEntry(&entry);
+            if (error != E_SUCCESS || !api_checkAvailability(data, "08001", "MODERNA", date)) {
+                failed = true;
+                fail_all = true;
+                passed = false;
+            } else {
+                api_getAvailabilityCacheStats(data, &hits, &misses);
+                if (hits != 1 || misses != 3) {
+                    failed = true;
+                    fail_all = true;
+                    passed = false;
+                }
+            }
+        }
+    }
+    end_test(test_section, "PR4_EX1_3", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 2 of PR4
+bool run_pr4_ex2(tTestSection* test_section, const char* input) {
+    tDate date1, date2;
+    tDateTime dt1;
+    bool passed = true;
+    bool failed = false;
+    
+    /////////////////////////////
+    /////  PR4 EX2 TEST 1  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX2_1", "Convert dates to day numbers");
+    date_parse(&date1, "01/01/1970");
+    date_parse(&date2, "29/02/2024");
+    if (date_toDays(date1) != 0 || date_toDays(date2) != 19782) {
+        failed = true;
+        passed = false;
+    } else {
+        date_parse(&date1, "31/12/1969");
+        if (date_toDays(date1) != -1) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX2_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX2 TEST 2  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX2_2", "Add days across months, years and leap days");
+    date_parse(&date1, "20/02/2024");
+    date_addDay(&date1, 21);
+    date_parse(&date2, "12/03/2024");
+    if (date_cmp(date1, date2) != 0) {
+        failed = true;
+        passed = false;
+    } else {
+        date_parse(&date1, "15/12/2021");
+        date_addDay(&date1, 21);
+        date_parse(&date2, "05/01/2022");
+        if (date_cmp(date1, date2) != 0 || date_diffDays(date2, date1) != 0) {
+            failed = true;
+            passed = false;
+        } else {
+            date_addDay(&date1, -36);
+            date_parse(&date2, "30/11/2021");
+            if (date_cmp(date1, date2) != 0) {
+                failed = true;
+                passed = false;
+            }
+        }
+    }
+    end_test(test_section, "PR4_EX2_2", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX2 TEST 3  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX2_3", "Adding days keeps the time of the day");
+    dateTime_parse(&dt1, "27/03/2022", "01:30");
+    dateTime_addDay(&dt1, 1);
+    if (dt1.date.day != 28 || dt1.date.month != 3 || dt1.time.hour != 1 || dt1.time.minutes != 30) {
+        failed = true;
+        passed = false;
+    }
+    end_test(test_section, "PR4_EX2_3", !failed);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 3 of PR4
+bool run_pr4_ex3(tTestSection* test_section, const char* input) {
+    tDateTime dt1, dt2;
+    tVaccine vaccine;
+    tVaccineStockData stock;
+    tVaccineDailyStock* pDay;
+    tDate date;
+    int i;
+    bool passed = true;
+    bool failed = false;
+    
+    /////////////////////////////
+    /////  PR4 EX3 TEST 1  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX3_1", "Convert a timestamp to a packed key and back");
+    dateTime_parse(&dt1, "29/02/2024", "23:59");
+    dateTime_fromKey(&dt2, dateTime_toKey(dt1));
+    if (!dateTime_equals(dt1, dt2)) {
+        failed = true;
+        passed = false;
+    } else {
+        dateTime_parse(&dt1, "01/01/1900", "00:01");
+        if (dateTime_toKey(dt1) != 1) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX3_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX3 TEST 2  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX3_2", "Packed keys keep the order of timestamps");
+    dateTime_parse(&dt1, "31/12/2021", "23:59");
+    dateTime_parse(&dt2, "01/01/2022", "00:00");
+    if (dateTime_toKey(dt1) + 1 != dateTime_toKey(dt2) || dateTime_cmp(dt1, dt2) != -1 || dateTime_cmp(dt2, dt1) != 1) {
+        failed = true;
+        passed = false;
+    }
+    end_test(test_section, "PR4_EX3_2", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX3 TEST 3  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX3_3", "Find the daily stock of any day of the list");
+    vaccine_init(&vaccine, "PFIZER", 2, 21);
+    stockList_init(&stock);
+    // Grow the list on both sides and remove the empty days at the start
+    date_parse(&date, "10/03/2022");
+    stockList_update(&stock, date, &vaccine, 5);
+    date_addDay(&date, -5);
+    stockList_update(&stock, date, &vaccine, 2);
+    date_addDay(&date, 20);
+    stockList_update(&stock, date, &vaccine, 1);
+    date_addDay(&date, -20);
+    stockList_update(&stock, date, &vaccine, -2);
+    date_parse(&date, "10/03/2022");
+    if (stock.count != 16 || stockList_find(&stock, date) != stock.first || stockList_find(&stock, stock.last->day) != stock.last) {
+        failed = true;
+        passed = false;
+    }
+    for (i = 0; i < stock.count && !failed; i++) {
+        pDay = stockList_find(&stock, date);
+        if (pDay == NULL || date_cmp(pDay->day, date) != 0 || stockNode_getDoses(pDay->first, &vaccine) != (i < 15 ? 5 : 6)) {
+            failed = true;
+            passed = false;
+        }
+        date_addDay(&date, 1);
+    }
+    date_parse(&date, "09/03/2022");
+    if (!failed && stockList_find(&stock, date) != NULL) {
+        failed = true;
+        passed = false;
+    }
+    stockList_free(&stock);
+    vaccine_free(&vaccine);
+    end_test(test_section, "PR4_EX3_3", !failed);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 4 of PR4
+bool run_pr4_ex4(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tCSVEntry entry;
+    tDate date;
+    tTime time;
+    char line[128];
+    int value;
+    float real;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    /////////////////////////////
+    /////  PR4 EX4 TEST 1  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX4_1", "Parse valid dates and times");
+    if (!date_parse(&date, "29/02/2024") || date.day != 29 || date.month != 2 || date.year != 2024) {
+        failed = true;
+        passed = false;
+    } else if (!time_parse(&time, "23:05") || time.hour != 23 || time.minutes != 5) {
+        failed = true;
+        passed = false;
+    }
+    end_test(test_section, "PR4_EX4_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX4 TEST 2  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX4_2", "Reject malformed dates and times");
+    if (date_parse(&date, "29/02/2022") || date_parse(&date, "1/1/2022") || date_parse(&date, "01/13/2022") || 
+        date_parse(&date, "01/01/2022 ") || date_parse(&date, "aa/01/2022") || date_parse(&date, "") || date_parse(&date, "31/12/1899")) {
+        failed = true;
+        passed = false;
+    } else if (time_parse(&time, "24:00") || time_parse(&time, "10:60") || time_parse(&time, "1:30") || time_parse(&time, "10-30")) {
+        failed = true;
+        passed = false;
+    }
+    end_test(test_section, "PR4_EX4_2", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX4 TEST 3  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX4_3", "Parse integer and real numbers");
+    if (!csv_parseInteger("-120", &value) || value != -120 || csv_parseInteger("12a", &value) || value != 12 || csv_parseInteger("", &value)) {
+        failed = true;
+        passed = false;
+    } else if (!csv_parseReal("3.25", &real) || real != 3.25f || !csv_parseReal("-2.5e2", &real) || real != -250.0f || csv_parseReal("3,25", &real)) {
+        failed = true;
+        passed = false;
+    }
+    end_test(test_section, "PR4_EX4_3", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX4 TEST 4  //////
+    /////////////////////////////    
+    failed = false;
+    start_test(test_section, "PR4_EX4_4", "Malformed entries are reported as invalid format");
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {
+        failed = true;
+        fail_all = true;
+        passed = false;
+    } else {
+        csv_initEntry(&entry);
+        csv_parseEntry(&entry, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30-12-1980", NULL);
+        error = api_addDataEntry(&data, entry);
+        csv_freeEntry(&entry);
+        if (error != E_INVALID_ENTRY_FORMAT || api_populationCount(data) != 0) {
+            failed = true;
+            passed = false;
+        }
+        
+        csv_initEntry(&entry);
+        csv_parseEntry(&entry, "01/04/2022;13:45;08001;PFIZER;2;21;many", "VACCINE_LOT");
+        error = api_addVaccineLot(&data, entry);
+        csv_freeEntry(&entry);
+        if (error != E_INVALID_ENTRY_FORMAT || api_vaccineLotsCount(data) != 0 || api_vaccineCount(data) != 0) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Dates before the origin of the packed keys are not accepted
+        strcpy(line, "VACCINE_LOT;01/01/1899;13:45;08001;PFIZER;2;21;5");
+        if (api_addDataLine(&data, line) != E_INVALID_ENTRY_FORMAT || api_vaccineLotsCount(data) != 0) {
+            failed = true;
+            passed = false;
+        }
+        
+        api_freeData(&data);
+    }
+    end_test(test_section, "PR4_EX4_4", !failed && !fail_all);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 5 of PR4
+bool run_pr4_ex5(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    char line[256];
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX5 TEST 1  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX5_1", "Add valid lines");
+    if (!fail_all) {
+        strcpy(line, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/04/2022;13:45;08001;PFIZER;2;21;1");
+            error = api_addDataLine(&data, line);
+        }
+        if (error != E_SUCCESS || api_populationCount(data) != 1 || api_vaccineLotsCount(data) != 1 || api_vaccineCount(data) != 1 || api_centersCount(data) != 1) {
+            failed = true;
+            fail_all = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX5_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX5 TEST 2  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX5_2", "Invalid lines keep the errors of entries");
+    if (!fail_all) {
+        strcpy(line, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        if (api_addDataLine(&data, line) != E_DUPLICATED_PERSON) {
+            failed = true;
+            passed = false;
+        }
+        strcpy(line, "VACCINE_LOT;01/04/2022;13:45;08001;PFIZER;2;21");
+        if (api_addDataLine(&data, line) != E_INVALID_ENTRY_FORMAT) {
+            failed = true;
+            passed = false;
+        }
+        strcpy(line, "CONTACT;87654321K;John");
+        if (api_addDataLine(&data, line) != E_INVALID_ENTRY_TYPE) {
+            failed = true;
+            passed = false;
+        }
+        if (api_populationCount(data) != 1 || api_vaccineLotsCount(data) != 1) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX5_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 6 of PR4
+bool run_pr4_ex6(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiData other;
+    tApiError error;
+    tCSVEntry entry;
+    char line[64];
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX6 TEST 1  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX6_1", "Known entry types are interned when parsed");
+    if (!fail_all) {
+        csv_initEntry(&entry);
+        csv_parseEntry(&entry, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980", NULL);
+        if (csv_getTypeId(&entry) != csv_findType("PERSON") || csv_getTypeId(&entry) != CSV_TYPE_PERSON || 
+            entry.type != csv_typeName(csv_getTypeId(&entry)) || strcmp(csv_getType(&entry), "PERSON") != 0) {
+            failed = true;
+            passed = false;
+        }
+        csv_freeEntry(&entry);
+        
+        csv_initEntry(&entry);
+        csv_parseEntry(&entry, "08001;John", "UNREGISTERED_TYPE");
+        if (csv_getTypeId(&entry) != CSV_UNKNOWN_TYPE || strcmp(csv_getType(&entry), "UNREGISTERED_TYPE") != 0) {
+            failed = true;
+            passed = false;
+        }
+        csv_freeEntry(&entry);
+    }
+    end_test(test_section, "PR4_EX6_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX6 TEST 2  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX6_2", "Register a handler for a new entry type");
+    if (!fail_all) {
+        test_pr4_handled = 0;
+        strcpy(line, "CENTER;08015");
+        if (api_addDataLine(&data, line) != E_INVALID_ENTRY_TYPE) {
+            failed = true;
+            passed = false;
+        } else if (api_registerEntryType(&data, "CENTER", test_pr4_addCenter) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        } else {
+            strcpy(line, "CENTER;08015");
+            error = api_addDataLine(&data, line);
+            csv_initEntry(&entry);
+            csv_parseEntry(&entry, "CENTER;08016", NULL);
+            if (error == E_SUCCESS) {
+                error = api_addDataEntry(&data, entry);
+            }
+            csv_freeEntry(&entry);
+            if (error != E_SUCCESS || test_pr4_handled != 2 || api_centersCount(data) != 2) {
+                failed = true;
+                passed = false;
+            }
+            
+            // The type is only registered on this data, the parser does not know it
+            if (api_initData(&other) != E_SUCCESS) {
+                failed = true;
+                passed = false;
+            } else {
+                strcpy(line, "CENTER;08017");
+                if (csv_findType("CENTER") != CSV_UNKNOWN_TYPE || api_addDataLine(&other, line) != E_INVALID_ENTRY_TYPE || test_pr4_handled != 2) {
+                    failed = true;
+                    passed = false;
+                }
+                api_freeData(&other);
+            }
+        }
+    }
+    end_test(test_section, "PR4_EX6_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 7 of PR4
+bool run_pr4_ex7(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tStringArena arena;
+    char line[128];
+    char *str1;
+    char *str2;
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX7 TEST 1  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX7_1", "Strings are stored contiguously on the arena");
+    if (!fail_all) {
+        stringArena_init(&arena);
+        str1 = stringArena_strdup(&arena, "08001");
+        str2 = stringArena_strdup(&arena, "08002");
+        if (strcmp(str1, "08001") != 0 || strcmp(str2, "08002") != 0 || str2 != str1 + 6 || stringArena_size(&arena) != 12 || arena.blocks != 1) {
+            failed = true;
+            passed = false;
+        }
+        // Fill more than one block
+        for (i = 0; i < STRING_ARENA_BLOCK_SIZE / 6 + 1; i++) {
+            stringArena_strdup(&arena, "08003");
+        }
+        if (strcmp(str1, "08001") != 0 || arena.blocks != 2) {
+            failed = true;
+            passed = false;
+        }
+        stringArena_free(&arena);
+        if (arena.first != NULL || stringArena_size(&arena) != 0) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX7_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX7 TEST 2  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX7_2", "Person, lot and center text fields are stored on the API arena");
+    if (!fail_all) {
+        strcpy(line, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;PFIZER;2;21;300");
+            error = api_addDataLine(&data, line);
+        }
+        // 10 + 5 + 6 + 23 + 14 bytes for the person and 6 for the cp shared with the lot and the new center
+        if (error != E_SUCCESS || api_getStringsSize(data) != 64 || api_populationCount(data) != 1 || 
+            strcmp(population_getContact(&(data.population), 0)->email, "john.smith@example.com") != 0 || strcmp(data.vaccineLots.elems[0].cp, "08001") != 0) {
+            failed = true;
+            passed = false;
+        }
+        population_del(&(data.population), "87654321K");
+        if (api_populationCount(data) != 0) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX7_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 8 of PR4
+bool run_pr4_ex8(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tPostalCodeTable table;
+    tHealthCenter *pCenter;
+    char line[128];
+    char cp[6];
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX8 TEST 1  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX8_1", "Postal codes get dense identifiers");
+    if (!fail_all) {
+        postalCodeTable_init(&table, NULL);
+        // Add enough codes to grow the hash table
+        for (i = 0; i < 200; i++) {
+            sprintf(cp, "%05d", 8000 + i);
+            if (postalCodeTable_intern(&table, cp) != i) {
+                failed = true;
+                passed = false;
+            }
+        }
+        if (postalCodeTable_len(&table) != 200 || postalCodeTable_find(&table, "08100") != 100 || 
+            postalCodeTable_intern(&table, "08100") != 100 || strcmp(postalCodeTable_get(&table, 100), "08100") != 0 ||
+            postalCodeTable_find(&table, "25001") != POSTAL_CODE_UNKNOWN) {
+            failed = true;
+            passed = false;
+        }
+        postalCodeTable_free(&table);
+    }
+    end_test(test_section, "PR4_EX8_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX8 TEST 2  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX8_2", "Persons, lots and centers share the interned postal codes");
+    if (!fail_all) {
+        strcpy(line, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;PFIZER;2;21;300");
+            error = api_addDataLine(&data, line);
+        }
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08002;PFIZER;2;21;300");
+            error = api_addDataLine(&data, line);
+        }
+        pCenter = centerList_find(&(data.centers), "08001");
+        if (error != E_SUCCESS || api_postalCodesCount(data) != 2 || pCenter == NULL || 
+            pCenter->cp != data.population.elems[0].cp || pCenter->cp != data.vaccineLots.elems[0].cp ||
+            pCenter->cpId != data.population.elems[0].cpId || centerList_findById(&(data.centers), pCenter->cpId) != pCenter ||
+            centerList_find(&(data.centers), "08003") != NULL) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX8_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 9 of PR4
+bool run_pr4_ex9(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tPopulation population;
+    tPerson person;
+    tPersonContact contact;
+    tPersonContact *pContact;
+    tCSVEntry entry;
+    char line[128];
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX9 TEST 1  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX9_1", "Contact data is kept apart from the person");
+    if (!fail_all) {
+        strcpy(line, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "PERSON;98765432J;Jane;Doe;jane.doe@example.com;Her street, 5;08002;01/02/1990");
+            error = api_addDataLine(&data, line);
+        }
+        pContact = error == E_SUCCESS ? population_getContact(&(data.population), 1) : NULL;
+        if (error != E_SUCCESS || sizeof(tPerson) > 40 || pContact == NULL || strcmp(pContact->name, "Jane") != 0 || 
+            strcmp(pContact->surname, "Doe") != 0 || strcmp(pContact->address, "Her street, 5") != 0 || 
+            strcmp(data.population.elems[1].document, "98765432J") != 0 || data.population.elems[1].birthday.year != 1990) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Persons parsed from an entry keep their contact data
+        population_init(&population);
+        person_init(&person);
+        personContact_init(&contact);
+        csv_initEntry(&entry);
+        csv_parseEntry(&entry, "98765432J;Jane;Doe;jane.doe@example.com;Her street, 5;08002;01/02/1990", "PERSON");
+        if (!person_parse(&person, &contact, entry)) {
+            failed = true;
+            passed = false;
+        } else {
+            population_add(&population, person, contact);
+            pContact = population_getContact(&population, 0);
+            if (population_len(population) != 1 || strcmp(pContact->name, "Jane") != 0 || strcmp(pContact->email, "jane.doe@example.com") != 0 ||
+                strcmp(pContact->address, "Her street, 5") != 0 || strcmp(population.elems[0].cp, "08002") != 0) {
+                failed = true;
+                passed = false;
+            }
+        }
+        csv_freeEntry(&entry);
+        person_free(&person);
+        personContact_free(&contact);
+        population_free(&population);
+    }
+    end_test(test_section, "PR4_EX9_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX9 TEST 2  //////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX9_2", "Contact data follows the person when the population changes");
+    if (!fail_all) {
+        population_del(&(data.population), "87654321K");
+        pContact = api_populationCount(data) == 1 ? population_getContact(&(data.population), 0) : NULL;
+        if (pContact == NULL || strcmp(data.population.elems[0].document, "98765432J") != 0 || strcmp(pContact->email, "jane.doe@example.com") != 0) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX9_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 10 of PR4
+bool run_pr4_ex10(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    char line[128];
+    char document[16];
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX10 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX10_1", "Documents are packed with the order of their strings");
+    if (!fail_all) {
+        if (document_toKey("87654321K") == DOCUMENT_KEY_NONE || document_toKey("X1234567L") == DOCUMENT_KEY_NONE ||
+            document_toKey("8765432K") != DOCUMENT_KEY_NONE || document_toKey("87654321k") != DOCUMENT_KEY_NONE ||
+            document_toKey("A1234567L") != DOCUMENT_KEY_NONE || document_toKey("87654321KK") != DOCUMENT_KEY_NONE ||
+            document_toKey("12345678Z") >= document_toKey("87654321K") || document_toKey("87654321K") >= document_toKey("X1234567L") ||
+            document_toKey("X1234567L") >= document_toKey("Y0000000Z") || document_toKey("87654321J") >= document_toKey("87654321K") ||
+            document_cmp(document_toKey("PASSPORT"), "PASSPORT", document_toKey("87654321K"), "87654321K") <= 0 ||
+            !document_equals(DOCUMENT_KEY_NONE, "PASSPORT", DOCUMENT_KEY_NONE, "PASSPORT") ||
+            document_equals(document_toKey("87654321K"), "87654321K", DOCUMENT_KEY_NONE, "PASSPORT")) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX10_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX10 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX10_2", "Check letters of DNI and NIE documents");
+    if (!fail_all) {
+        if (!document_isValid("12345678Z") || !document_isValid("X1234567L") || !document_isValid("Y1234567X") ||
+            document_isValid("12345678Q") || document_isValid("X1234567T") || document_isValid("PASSPORT")) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX10_2", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX10 TEST 3  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX10_3", "Find persons on the population hash table");
+    if (!fail_all) {
+        // Enough persons to grow the hash table, with a non conforming document
+        for (i = 0; i < 100 && !failed; i++) {
+            sprintf(document, "%08dZ", 10000000 + i);
+            sprintf(line, "PERSON;%s;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980", document);
+            if (api_addDataLine(&data, line) != E_SUCCESS) {
+                failed = true;
+                passed = false;
+            }
+        }
+        strcpy(line, "PERSON;PASSPORT-1;John;Doe;john.doe@example.com;My street, 25;08001;30/12/1980");
+        error = api_addDataLine(&data, line);
+        strcpy(line, "PERSON;10000050Z;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        if (error != E_SUCCESS || api_addDataLine(&data, line) != E_DUPLICATED_PERSON || api_populationCount(data) != 101 ||
+            population_find(data.population, "10000050Z") != 50 || population_find(data.population, "PASSPORT-1") != 100 ||
+            population_find(data.population, "10000150Z") != -1) {
+            failed = true;
+            passed = false;
+        }
+        // Positions are updated when a person is removed
+        population_del(&(data.population), "10000010Z");
+        if (population_find(data.population, "10000050Z") != 49 || population_find(data.population, "10000010Z") != -1) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX10_3", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX10 TEST 4  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX10_4", "Reject persons with a wrong check letter when validation is enabled");
+    if (!fail_all) {
+        strcpy(line, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        api_setDocumentValidation(&data, true);
+        error = api_addDataLine(&data, line);
+        strcpy(line, "PERSON;12345678Z;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        if (error != E_INVALID_DOCUMENT || api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        strcpy(line, "PERSON;87654321K;John;Smith;john.smith@example.com;My street, 25;08001;30/12/1980");
+        api_setDocumentValidation(&data, false);
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX10_4", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 11 of PR4
+bool run_pr4_ex11(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tPerson *pLast;
+    char line[128];
+    const char* cps[] = {"08001", "08002", "17001", "08001", "25001", "08001"};
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX11 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX11_1", "Visit the residents of a postal code");
+    if (!fail_all) {
+        for (i = 0; i < 6 && !failed; i++) {
+            sprintf(line, "PERSON;1000000%dZ;John;Smith;john.smith@example.com;My street, 25;%s;30/12/1980", i, cps[i]);
+            if (api_addDataLine(&data, line) != E_SUCCESS) {
+                failed = true;
+                passed = false;
+            }
+        }
+        pLast = NULL;
+        if (failed || api_visitResidents(data, "08001", test_pr4_lastPerson, &pLast) != 3 || pLast == NULL || 
+            strcmp(pLast->document, "10000005Z") != 0 || api_visitResidents(data, "08003", test_pr4_lastPerson, &pLast) != 0) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX11_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX11 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX11_2", "Visit the residents of a region");
+    if (!fail_all) {
+        if (api_visitRegionResidents(data, "08", test_pr4_lastPerson, &pLast) != 4 || 
+            api_visitRegionResidents(data, "", test_pr4_lastPerson, &pLast) != 6 ||
+            api_visitRegionResidents(data, "3", test_pr4_lastPerson, &pLast) != 0) {
+            failed = true;
+            passed = false;
+        }
+        // Lists are updated when a person is removed
+        population_del(&(data.population), "10000000Z");
+        pLast = NULL;
+        if (api_visitResidents(data, "08001", test_pr4_lastPerson, &pLast) != 2 || pLast == NULL || 
+            strcmp(pLast->document, "10000005Z") != 0 || api_visitRegionResidents(data, "08", test_pr4_lastPerson, &pLast) != 3) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX11_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 12 of PR4
+bool run_pr4_ex12(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tDate cutoff;
+    tDateTime timestamp;
+    char line[128];
+    char documents[128];
+    const char* birthdays[] = {"30/12/1980", "01/01/1950", "15/06/2001", "01/01/1950", "20/03/1965"};
+    const char* cps[] = {"08001", "08002", "08001", "08001", "08001"};
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX12 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX12_1", "Visit the persons born before a date, from the oldest one");
+    if (!fail_all) {
+        for (i = 0; i < 5 && !failed; i++) {
+            sprintf(line, "PERSON;1000000%dZ;John;Smith;john.smith@example.com;My street, 25;%s;%s", i, cps[i], birthdays[i]);
+            if (api_addDataLine(&data, line) != E_SUCCESS) {
+                failed = true;
+                passed = false;
+            }
+        }
+        date_parse(&cutoff, "01/01/1981");
+        documents[0] = '\0';
+        if (failed || api_getEligibleCohort(&data, cutoff, NULL, test_pr4_appendDocument, documents) != 4 || 
+            strcmp(documents, "10000001Z;10000003Z;10000004Z;10000000Z;") != 0) {
+            failed = true;
+            passed = false;
+        }
+        documents[0] = '\0';
+        if (api_getEligibleCohort(&data, cutoff, "08001", test_pr4_appendDocument, documents) != 3 || 
+            strcmp(documents, "10000003Z;10000004Z;10000000Z;") != 0 ||
+            api_getEligibleCohort(&data, cutoff, "08003", test_pr4_appendDocument, documents) != 0) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX12_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX12 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX12_2", "Persons with appointments are not eligible");
+    if (!fail_all) {
+        strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;PFIZER;2;21;300");
+        error = api_addDataLine(&data, line);
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        if (error == E_SUCCESS) {
+            error = api_addAppointment(&data, "08001", "10000003Z", "PFIZER", timestamp);
+        }
+        documents[0] = '\0';
+        if (error != E_SUCCESS || api_getEligibleCohort(&data, cutoff, "08001", test_pr4_appendDocument, documents) != 2 || 
+            strcmp(documents, "10000004Z;10000000Z;") != 0) {
+            failed = true;
+            passed = false;
+        }
+        // The index follows removed persons
+        api_deletePerson(&data, "10000000Z");
+        documents[0] = '\0';
+        if (api_getEligibleCohort(&data, cutoff, NULL, test_pr4_appendDocument, documents) != 2 || 
+            strcmp(documents, "10000001Z;10000004Z;") != 0 || !population_isScheduled(&(data.population), 2)) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX12_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 13 of PR4
+bool run_pr4_ex13(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tBitmap a, b, result;
+    tDate cutoff;
+    tDateTime timestamp;
+    char line[128];
+    char documents[128];
+    const char* birthdays[] = {"30/12/1980", "01/01/1950", "15/06/2001", "01/01/1950", "20/03/1965"};
+    const char* cps[] = {"08001", "08002", "08001", "08001", "17001"};
+    uint64_t sum;
+    uint32_t i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    bitmap_init(&a);
+    bitmap_init(&b);
+    bitmap_init(&result);
+    
+    /////////////////////////////
+    /////  PR4 EX13 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX13_1", "Add, remove and count bitmap values");
+    if (!fail_all) {
+        // Even values up to 20000 fill a bitset container. Multiples of 3 are sparse arrays on three containers
+        for (i = 0; i < 20000; i += 2) {
+            bitmap_add(&a, i);
+        }
+        for (i = 0; i < 150000; i += 3) {
+            bitmap_add(&b, i);
+        }
+        bitmap_add(&b, 3000000000u);
+        bitmap_add(&b, 3);
+        if (bitmap_cardinality(&a) != 10000 || bitmap_cardinality(&b) != 50001 || a.containers[0].bits == NULL ||
+            !bitmap_contains(&a, 19998) || bitmap_contains(&a, 19999) || !bitmap_contains(&b, 3000000000u) || bitmap_contains(&b, 3000000001u)) {
+            failed = true;
+            passed = false;
+        }
+        bitmap_remove(&b, 3000000000u);
+        bitmap_remove(&a, 1);
+        bitmap_remove(&a, 2);
+        if (bitmap_cardinality(&a) != 9999 || bitmap_contains(&a, 2) || bitmap_cardinality(&b) != 50000 || b.count != 3) {
+            failed = true;
+            passed = false;
+        }
+        // Remove 4 and move down the next values
+        bitmap_removeShift(&a, 4);
+        if (bitmap_cardinality(&a) != 9998 || !bitmap_contains(&a, 5) || bitmap_contains(&a, 6) || !bitmap_contains(&a, 0)) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX13_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX13 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX13_2", "Set operations between bitmaps");
+    if (!fail_all) {
+        // Even values on a bitset, and multiples of 3 on arrays
+        bitmap_free(&a);
+        bitmap_free(&b);
+        for (i = 0; i < 20000; i += 2) {
+            bitmap_add(&a, i);
+        }
+        for (i = 0; i < 150000; i += 3) {
+            bitmap_add(&b, i);
+        }
+        
+        // Multiples of 6 up to 19998
+        bitmap_and(&a, &b, &result);
+        sum = 0;
+        bitmap_visit(&result, test_pr4_sumValues, &sum);
+        if (bitmap_cardinality(&result) != 3334 || sum != 33336666) {
+            failed = true;
+            passed = false;
+        }
+        bitmap_or(&a, &b, &result);
+        if (bitmap_cardinality(&result) != 10000 + 50000 - 3334 || !bitmap_contains(&result, 19998) || !bitmap_contains(&result, 149997)) {
+            failed = true;
+            passed = false;
+        }
+        bitmap_andNot(&b, &a, &result);
+        if (bitmap_cardinality(&result) != 50000 - 3334 || bitmap_contains(&result, 12) || !bitmap_contains(&result, 9) || !bitmap_contains(&result, 149997)) {
+            failed = true;
+            passed = false;
+        }
+        // Operations can store the result on an input
+        bitmap_cpy(&result, &a);
+        bitmap_and(&result, &b, &result);
+        if (bitmap_cardinality(&result) != 3334) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX13_2", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX13 TEST 3  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX13_3", "Combine population sets");
+    if (!fail_all) {
+        for (i = 0; i < 5 && !failed; i++) {
+            sprintf(line, "PERSON;1000000%dZ;John;Smith;john.smith@example.com;My street, 25;%s;%s", i, cps[i], birthdays[i]);
+            if (api_addDataLine(&data, line) != E_SUCCESS) {
+                failed = true;
+                passed = false;
+            }
+        }
+        strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;PFIZER;2;21;300");
+        error = api_addDataLine(&data, line);
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        if (error == E_SUCCESS) {
+            error = api_addAppointment(&data, "08001", "10000003Z", "PFIZER", timestamp);
+        }
+        
+        // Residents of 080 born before 1981 without appointments
+        date_parse(&cutoff, "01/01/1981");
+        api_getResidentsSet(&data, "080", &a);
+        api_getBornBeforeSet(&data, cutoff, &b);
+        bitmap_and(&a, &b, &result);
+        api_getScheduledSet(&data, NULL, &b);
+        bitmap_andNot(&result, &b, &result);
+        documents[0] = '\0';
+        if (error != E_SUCCESS || api_visitPersonSet(&data, &result, test_pr4_appendDocument, documents) != 2 ||
+            strcmp(documents, "10000000Z;10000001Z;") != 0) {
+            failed = true;
+            passed = false;
+        }
+        api_getScheduledSet(&data, "PFIZER", &a);
+        api_getScheduledSet(&data, "MODERNA", &b);
+        if (bitmap_cardinality(&a) != 1 || !bitmap_contains(&a, 3) || bitmap_cardinality(&b) != 0) {
+            failed = true;
+            passed = false;
+        }
+        // Sets follow removed persons
+        api_deletePerson(&data, "10000000Z");
+        api_getScheduledSet(&data, "PFIZER", &a);
+        api_getResidentsSet(&data, "08001", &b);
+        if (!bitmap_contains(&a, 2) || bitmap_cardinality(&b) != 2 || !bitmap_contains(&b, 1) || !bitmap_contains(&b, 2)) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX13_3", !failed);
+    
+    // Release all data
+    bitmap_free(&a);
+    bitmap_free(&b);
+    bitmap_free(&result);
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 14 of PR4
+bool run_pr4_ex14(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tDateTime timestamp;
+    const tPersonBooking* pBooking;
+    tHealthCenter *pCenter1;
+    tHealthCenter *pCenter2;
+    tVaccine *pVaccine;
+    char line[128];
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX14 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX14_1", "Reject a person already booked in another center");
+    if (!fail_all) {
+        for (i = 0; i < 3 && !failed; i++) {
+            sprintf(line, "PERSON;1000000%dZ;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950", i);
+            if (api_addDataLine(&data, line) != E_SUCCESS) {
+                failed = true;
+                passed = false;
+            }
+        }
+        strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;MODERNA;1;0;300");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08500;MODERNA;1;0;300");
+            error = api_addDataLine(&data, line);
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        if (error == E_SUCCESS) {
+            error = api_findAppointmentAvailability(&data, "08001", "10000001Z", timestamp);
+        }
+        if (failed || error != E_SUCCESS ||
+            api_findAppointmentAvailability(&data, "08500", "10000001Z", timestamp) != E_DUPLICATED_PERSON ||
+            api_addAppointment(&data, "08500", "10000001Z", "MODERNA", timestamp) != E_DUPLICATED_PERSON) {
+            failed = true;
+            passed = false;
+        }
+        pBooking = population_getBooking(&(data.population), 1);
+        if (pBooking->doses != 1 || pBooking->centerId != postalCodeTable_find(data.cps, "08001") ||
+            population_isBooked(&(data.population), 0) || population_isBooked(&(data.population), 2)) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX14_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX14 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX14_2", "Booking state follows removed persons");
+    if (!fail_all) {
+        pCenter1 = centerList_find(&(data.centers), "08001");
+        pCenter2 = centerList_find(&(data.centers), "08500");
+        pVaccine = vaccineList_find(data.vaccines, "MODERNA");
+        
+        // The booked person moves to the removed position and keeps its series
+        api_deletePerson(&data, "10000000Z");
+        pBooking = population_getBooking(&(data.population), 0);
+        if (!population_isBooked(&(data.population), 0) || population_isBooked(&(data.population), 1) ||
+            pBooking->centerId != pCenter1->cpId || pCenter1->series.count != 1 || pCenter2->series.count != 0 ||
+            pCenter1->series.elems[pBooking->series].person != 0 ||
+            api_addAppointment(&data, "08500", "10000001Z", "MODERNA", timestamp) != E_DUPLICATED_PERSON) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Removing the booked person returns its stock and slot. It is not booked on any center
+        api_deletePerson(&data, "10000001Z");
+        if (population_len(data.population) != 1 || population_isBooked(&(data.population), 0) ||
+            population_isScheduled(&(data.population), 0) || pCenter1->series.count != 0 || pCenter2->series.count != 0 ||
+            stockList_getDoses(&(pCenter1->stock), timestamp.date, pVaccine) != 300 ||
+            stockList_getDoses(&(pCenter2->stock), timestamp.date, pVaccine) != 300 ||
+            slotCalendar_getUsed(&(pCenter1->slots), timestamp) != 0) {
+            failed = true;
+            passed = false;
+        }
+        
+        // The remaining person is booked on a single center
+        if (api_addAppointment(&data, "08500", "10000002Z", "MODERNA", timestamp) != E_SUCCESS ||
+            population_getBooking(&(data.population), 0)->centerId != pCenter2->cpId ||
+            pCenter1->series.count != 0 || pCenter2->series.count != 1 || pCenter2->series.elems[0].person != 0 ||
+            stockList_getDoses(&(pCenter1->stock), timestamp.date, pVaccine) != 300 ||
+            stockList_getDoses(&(pCenter2->stock), timestamp.date, pVaccine) != 299 ||
+            slotCalendar_getUsed(&(pCenter1->slots), timestamp) != 0 || slotCalendar_getUsed(&(pCenter2->slots), timestamp) != 1) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX14_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 15 of PR4
+bool run_pr4_ex15(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tVaccine vaccine;
+    tPerson persons[2];
+    tDoseSeries series;
+    tDoseSeriesData list;
+    tAppointmentData appointments;
+    tDateTime timestamp;
+    tDateTime dose;
+    tCSVData report;
+    tHealthCenter *pCenter;
+    char buffer[64];
+    char line[128];
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX15 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX15_1", "Expand the doses of a dose series");
+    if (!fail_all) {
+        vaccine_init(&vaccine, "PFIZER", 2, 21);
+        person_init(&(persons[0]));
+        person_init(&(persons[1]));
+        persons[0].document = "10000000Z";
+        persons[0].key = document_toKey(persons[0].document);
+        persons[1].document = "10000001Z";
+        persons[1].key = document_toKey(persons[1].document);
+        doseSeriesData_init(&list);
+        appointmentData_init(&appointments);
+        
+        dateTime_parse(&timestamp, "25/12/2021", "10:00");
+        doseSeries_init(&series, 0, &vaccine, timestamp);
+        dose = doseSeries_getDose(series, 1);
+        if (series.doses != 2 || series.interval != 21 || dose.date.day != 15 || dose.date.month != 1 || dose.date.year != 2022 || dose.time.hour != 10) {
+            failed = true;
+            passed = false;
+        }
+        doseSeriesData_add(&list, series);
+        dateTime_parse(&timestamp, "01/01/2022", "09:00");
+        doseSeries_init(&series, 1, &vaccine, timestamp);
+        if (doseSeriesData_add(&list, series) != 1) {
+            failed = true;
+            passed = false;
+        }
+        // Doses of both series are sorted by timestamp
+        doseSeriesData_expand(list, persons, &appointments);
+        if (appointments.count != 4 || appointments.elems[0].person != &(persons[0]) || appointments.elems[1].person != &(persons[1]) ||
+            appointments.elems[2].person != &(persons[0]) || appointments.elems[3].person != &(persons[1])) {
+            failed = true;
+            passed = false;
+        }
+        // The last series is moved to the removed position
+        doseSeriesData_remove(&list, 0);
+        if (list.count != 1 || list.elems[0].person != 1) {
+            failed = true;
+            passed = false;
+        }
+        
+        appointmentData_free(&appointments);
+        doseSeriesData_free(&list);
+        vaccine_free(&vaccine);
+    }
+    end_test(test_section, "PR4_EX15_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX15 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX15_2", "Book a multi-dose vaccine as a single dose series");
+    if (!fail_all) {
+        strcpy(line, "PERSON;10000000Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;PFIZER;2;21;300");
+            error = api_addDataLine(&data, line);
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        if (error == E_SUCCESS) {
+            error = api_findAppointmentAvailability(&data, "08001", "10000000Z", timestamp);
+        }
+        pCenter = centerList_find(&(data.centers), "08001");
+        if (error != E_SUCCESS || pCenter == NULL || pCenter->series.count != 1 || pCenter->series.elems[0].doses != 2) {
+            failed = true;
+            passed = false;
+        } else {
+            csv_init(&report);
+            error = api_getPersonAppointments(data, "10000000Z", &report);
+            if (error != E_SUCCESS || csv_numEntries(report) != 2) {
+                failed = true;
+                passed = false;
+            } else {
+                csv_getAsString(*csv_getEntry(report, 1), 0, buffer, 64);
+                if (strcmp(buffer, "24/01/2022") != 0) {
+                    failed = true;
+                    passed = false;
+                }
+            }
+            csv_free(&report);
+            
+            // Both doses were taken from the stock
+            dateTime_parse(&dose, "24/01/2022", "10:00");
+            if (stockList_getDoses(&(pCenter->stock), timestamp.date, pCenter->series.elems[0].vaccine) != 299 ||
+                stockList_getDoses(&(pCenter->stock), dose.date, pCenter->series.elems[0].vaccine) != 298) {
+                failed = true;
+                passed = false;
+            }
+        }
+    }
+    end_test(test_section, "PR4_EX15_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 16 of PR4
+bool run_pr4_ex16(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tVaccine vaccine;
+    tStockTimeline timeline;
+    tVaccineStockData stock1;
+    tVaccineStockData stock2;
+    tVaccineDailyStock *pDay1;
+    tVaccineDailyStock *pDay2;
+    tHealthCenter *pCenter;
+    tHealthCenter *pCenter2;
+    tVaccine *pVaccine;
+    tDateTime timestamp;
+    tDateTime now;
+    tDate date;
+    tCSVData report;
+    char buffer[64];
+    char line[128];
+    int hold1;
+    int hold2;
+    int day;
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX16 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX16_1", "Update the doses of a stock timeline");
+    if (!fail_all) {
+        vaccine_init(&vaccine, "PFIZER", 2, 21);
+        timeline_init(&timeline, &vaccine);
+        date_parse(&date, "01/01/2022");
+        day = date_toDays(date);
+        timeline_update(&timeline, day, 100);
+        timeline_update(&timeline, day + 10, -30);
+        // Grow to the right and to the left
+        timeline_update(&timeline, day + 500, 5);
+        timeline_update(&timeline, day - 300, 1);
+        if (timeline_getDoses(&timeline, day - 301) != 0 || timeline_getDoses(&timeline, day - 1) != 1 || 
+            timeline_getDoses(&timeline, day + 9) != 101 || timeline_getDoses(&timeline, day + 10) != 71 ||
+            timeline_getDoses(&timeline, day + 499) != 71 || timeline_getDoses(&timeline, day + 5000) != 76) {
+            failed = true;
+            passed = false;
+        }
+        timeline_free(&timeline);
+        
+        // Adjusted stocks give the same daily list once it is rebuilt
+        stockList_init(&stock1);
+        stockList_init(&stock2);
+        stockList_update(&stock1, date, &vaccine, 50);
+        stockList_adjust(&stock2, date, &vaccine, 50);
+        date_addDay(&date, 3);
+        stockList_update(&stock1, date, &vaccine, -50);
+        // Updates of a stale list are only applied to the timeline
+        stockList_update(&stock2, date, &vaccine, -50);
+        date_addDay(&date, -1);
+        if (stockList_getDoses(&stock2, date, &vaccine) != 50 || !stock2.stale || stock2.count != 0) {
+            failed = true;
+            passed = false;
+        }
+        stockList_sync(&stock2);
+        if (stock1.count != 3 || stock2.count != stock1.count || stock2.stale) {
+            failed = true;
+            passed = false;
+        } else {
+            pDay1 = stock1.first;
+            pDay2 = stock2.first;
+            while (pDay1 != NULL && !failed) {
+                if (date_cmp(pDay1->day, pDay2->day) != 0 || pDay2->first == NULL || pDay2->first->elem.doses != pDay1->first->elem.doses) {
+                    failed = true;
+                    passed = false;
+                }
+                pDay1 = pDay1->next;
+                pDay2 = pDay2->next;
+            }
+        }
+        stockList_free(&stock1);
+        stockList_free(&stock2);
+        vaccine_free(&vaccine);
+    }
+    end_test(test_section, "PR4_EX16_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX16 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX16_2", "Cancel appointments and return the doses");
+    if (!fail_all) {
+        strcpy(line, "PERSON;10000000Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "PERSON;10000001Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+            error = api_addDataLine(&data, line);
+        }
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;PFIZER;2;21;2");
+            error = api_addDataLine(&data, line);
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        if (error == E_SUCCESS) {
+            error = api_findAppointmentAvailability(&data, "08001", "10000000Z", timestamp);
+        }
+        // Only one person can have both doses
+        if (error != E_SUCCESS || api_checkAvailability(data, "08001", "PFIZER", timestamp.date)) {
+            failed = true;
+            passed = false;
+        }
+        if (!failed) {
+            pCenter = centerList_find(&(data.centers), "08001");
+            pVaccine = vaccineList_find(data.vaccines, "PFIZER");
+            error = api_addAppointment(&data, "08001", "10000001Z", "PFIZER", timestamp);
+            // The population is moved when it grows after the booking
+            for (i = 0; i < 2000 && error == E_SUCCESS; i++) {
+                sprintf(line, "PERSON;PASSPORT-%d;Jane;Smith;jane.smith@example.com;My street, 25;08001;01/01/1990", i);
+                error = api_addDataLine(&data, line);
+            }
+            if (error != E_SUCCESS || api_cancelAppointment(&data, "10000000Z") != E_SUCCESS ||
+                api_cancelAppointment(&data, "10000000Z") != E_APPOINTMENT_NOT_FOUND ||
+                api_cancelAppointment(&data, "10000009Z") != E_PERSON_NOT_FOUND) {
+                failed = true;
+                passed = false;
+            }
+            // The series of the other person is still found
+            csv_init(&report);
+            if (api_getPersonAppointments(data, "10000001Z", &report) != E_SUCCESS || report.count != 2 ||
+                pCenter->series.count != 1 || population_isBooked(&(data.population), 0) ||
+                stockList_getDoses(&(pCenter->stock), timestamp.date, pVaccine) != 1) {
+                failed = true;
+                passed = false;
+            }
+            csv_free(&report);
+            if (api_cancelAppointment(&data, "10000001Z") != E_SUCCESS || pCenter->series.count != 0 ||
+                stockList_getDoses(&(pCenter->stock), timestamp.date, pVaccine) != 2 ||
+                !api_checkAvailability(data, "08001", "PFIZER", timestamp.date)) {
+                failed = true;
+                passed = false;
+            }
+        }
+    }
+    end_test(test_section, "PR4_EX16_2", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX16 TEST 3  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX16_3", "Reschedule appointments");
+    if (!fail_all) {
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        error = api_addAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp);
+        // There is no stock before the lot
+        dateTime_parse(&timestamp, "20/12/2021", "10:00");
+        if (error != E_SUCCESS || api_rescheduleAppointment(&data, "10000000Z", timestamp) != E_NO_VACCINES ||
+            api_rescheduleAppointment(&data, "10000001Z", timestamp) != E_APPOINTMENT_NOT_FOUND) {
+            failed = true;
+            passed = false;
+        }
+        dateTime_parse(&timestamp, "10/01/2022", "12:30");
+        csv_init(&report);
+        if (!failed && (api_rescheduleAppointment(&data, "10000000Z", timestamp) != E_SUCCESS ||
+            api_getPersonAppointments(data, "10000000Z", &report) != E_SUCCESS || report.count != 2)) {
+            failed = true;
+            passed = false;
+        } else if (!failed) {
+            csv_getAsString(*csv_getEntry(report, 1), 0, buffer, 64);
+            date_parse(&date, "05/01/2022");
+            if (strcmp(buffer, "31/01/2022") != 0 || stockList_getDoses(&(pCenter->stock), date, pVaccine) != 2 ||
+                stockList_getDoses(&(pCenter->stock), timestamp.date, pVaccine) != 1) {
+                failed = true;
+                passed = false;
+            }
+        }
+        csv_free(&report);
+    }
+    end_test(test_section, "PR4_EX16_3", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX16 TEST 4  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX16_4", "Remove persons with appointments and holds");
+    if (!fail_all) {
+        strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08002;MODERNA;1;0;10");
+        error = api_addDataLine(&data, line);
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        dateTime_parse(&now, "01/01/2022", "12:00");
+        if (error == E_SUCCESS) {
+            error = api_addAppointment(&data, "08002", "10000001Z", "MODERNA", timestamp);
+        }
+        if (error == E_SUCCESS) {
+            error = api_holdAppointment(&data, "08002", "PASSPORT-0", "MODERNA", timestamp, now, 60, &hold1);
+        }
+        if (error == E_SUCCESS) {
+            error = api_holdAppointment(&data, "08002", "PASSPORT-1", "MODERNA", timestamp, now, 60, &hold2);
+        }
+        pCenter2 = centerList_find(&(data.centers), "08002");
+        pVaccine = vaccineList_find(data.vaccines, "MODERNA");
+        if (error != E_SUCCESS || pCenter2 == NULL || stockList_getDoses(&(pCenter2->stock), timestamp.date, pVaccine) != 7) {
+            failed = true;
+            passed = false;
+        }
+        
+        // The appointments of the removed person are cancelled and the next persons keep theirs
+        pVaccine = vaccineList_find(data.vaccines, "PFIZER");
+        date_parse(&date, "10/01/2022");
+        if (!failed && (api_deletePerson(&data, "10000000Z") != E_SUCCESS || api_deletePerson(&data, "10000000Z") != E_PERSON_NOT_FOUND ||
+            pCenter->series.count != 0 || stockList_getDoses(&(pCenter->stock), date, pVaccine) != 2 ||
+            pCenter2->series.count != 1 || strcmp(data.population.elems[pCenter2->series.elems[0].person].document, "10000001Z") != 0)) {
+            failed = true;
+            passed = false;
+        }
+        csv_init(&report);
+        if (!failed && (api_getPersonAppointments(data, "10000001Z", &report) != E_SUCCESS || report.count != 1)) {
+            failed = true;
+            passed = false;
+        }
+        csv_free(&report);
+        
+        // The holds of the removed person return the doses and the next holds can be confirmed
+        pVaccine = vaccineList_find(data.vaccines, "MODERNA");
+        if (!failed && (api_deletePerson(&data, "PASSPORT-1") != E_SUCCESS || stockList_getDoses(&(pCenter2->stock), timestamp.date, pVaccine) != 8 ||
+            api_confirmHold(&data, hold2) != E_HOLD_NOT_FOUND || api_confirmHold(&data, hold1) != E_SUCCESS ||
+            stockList_getDoses(&(pCenter2->stock), timestamp.date, pVaccine) != 8 || pCenter2->series.count != 2 ||
+            strcmp(data.population.elems[pCenter2->series.elems[1].person].document, "PASSPORT-0") != 0)) {
+            failed = true;
+            passed = false;
+        }
+        
+        // The series moved by a cancellation still refer to their persons
+        if (!failed && (api_cancelAppointment(&data, "10000001Z") != E_SUCCESS || api_cancelAppointment(&data, "PASSPORT-0") != E_SUCCESS ||
+            pCenter2->series.count != 0 || stockList_getDoses(&(pCenter2->stock), timestamp.date, pVaccine) != 10)) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX16_4", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 17 of PR4
+bool run_pr4_ex17(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tWaitlist waitlist;
+    tWaitlistEntry entry;
+    tPerson persons[3];
+    tDateTime timestamp;
+    tCSVData report;
+    char buffer[64];
+    char line[128];
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX17 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX17_1", "Serve the waitlist by birthday and request time");
+    if (!fail_all) {
+        for (i = 0; i < 3; i++) {
+            person_init(&(persons[i]));
+        }
+        date_parse(&(persons[0].birthday), "01/01/1980");
+        date_parse(&(persons[1].birthday), "01/01/1950");
+        date_parse(&(persons[2].birthday), "01/01/1950");
+        waitlist_init(&waitlist);
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        waitlist_push(&waitlist, 0, persons[0].birthday, timestamp);
+        waitlist_push(&waitlist, 1, persons[1].birthday, timestamp);
+        dateTime_parse(&timestamp, "03/01/2022", "09:00");
+        waitlist_push(&waitlist, 2, persons[2].birthday, timestamp);
+        if (waitlist_len(waitlist) != 3 || !waitlist_pop(&waitlist, &entry) || entry.person != 2 ||
+            !waitlist_pop(&waitlist, &entry) || entry.person != 1 ||
+            !waitlist_pop(&waitlist, &entry) || entry.person != 0 || waitlist_pop(&waitlist, &entry)) {
+            failed = true;
+            passed = false;
+        }
+        // Requests of removed persons are dropped and the next persons move one position down
+        for (i = 0; i < 3; i++) {
+            waitlist_push(&waitlist, i, persons[i].birthday, timestamp);
+        }
+        waitlist_delPerson(&waitlist, 1);
+        if (waitlist_len(waitlist) != 2 || !waitlist_pop(&waitlist, &entry) || entry.person != 1 ||
+            !waitlist_pop(&waitlist, &entry) || entry.person != 0) {
+            failed = true;
+            passed = false;
+        }
+        waitlist_free(&waitlist);
+    }
+    end_test(test_section, "PR4_EX17_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX17 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX17_2", "Book waiting persons when a lot arrives");
+    if (!fail_all) {
+        strcpy(line, "PERSON;10000000Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1990");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "PERSON;10000001Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1960");
+            error = api_addDataLine(&data, line);
+        }
+        if (error == E_SUCCESS) {
+            strcpy(line, "PERSON;10000002Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1940");
+            error = api_addDataLine(&data, line);
+        }
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;MODERNA;1;0;1");
+            error = api_addDataLine(&data, line);
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        if (error == E_SUCCESS) {
+            error = api_findAppointmentAvailability(&data, "08001", "10000000Z", timestamp);
+        }
+        // Requests without stock wait only once on the center
+        if (error != E_SUCCESS || api_findAppointmentAvailability(&data, "08001", "10000001Z", timestamp) != E_NO_VACCINES ||
+            api_findAppointmentAvailability(&data, "08001", "10000002Z", timestamp) != E_NO_VACCINES ||
+            api_findAppointmentAvailability(&data, "08001", "10000001Z", timestamp) != E_NO_VACCINES ||
+            api_waitlistCount(data, "08001") != 2) {
+            failed = true;
+            passed = false;
+        }
+        
+        // The population is moved when it grows while the persons are waiting
+        for (i = 0; i < 2000 && !failed; i++) {
+            sprintf(line, "PERSON;PASSPORT-%d;Jane;Smith;jane.smith@example.com;My street, 25;08002;01/01/1930", i);
+            if (api_addDataLine(&data, line) != E_SUCCESS) {
+                failed = true;
+                passed = false;
+            }
+        }
+        
+        // The oldest person gets the dose of the new lot
+        strcpy(line, "VACCINE_LOT;05/01/2022;10:00;08001;MODERNA;1;0;1");
+        if (!failed && (api_addDataLine(&data, line) != E_SUCCESS || api_waitlistCount(data, "08001") != 1 ||
+            !population_isBooked(&(data.population), 2) || population_isBooked(&(data.population), 1))) {
+            failed = true;
+            passed = false;
+        }
+        csv_init(&report);
+        if (!failed && (api_getPersonAppointments(data, "10000002Z", &report) != E_SUCCESS || report.count != 1)) {
+            failed = true;
+            passed = false;
+        } else if (!failed) {
+            csv_getAsString(*csv_getEntry(report, 0), 0, buffer, 64);
+            if (strcmp(buffer, "05/01/2022") != 0) {
+                failed = true;
+                passed = false;
+            }
+        }
+        csv_free(&report);
+        
+        strcpy(line, "VACCINE_LOT;06/01/2022;10:00;08001;MODERNA;1;0;1");
+        if (!failed && (api_addDataLine(&data, line) != E_SUCCESS || api_waitlistCount(data, "08001") != 0 ||
+            !population_isBooked(&(data.population), 1))) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX17_2", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX17 TEST 3  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX17_3", "Remove waiting persons");
+    if (!fail_all) {
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        if (api_findAppointmentAvailability(&data, "08001", "PASSPORT-0", timestamp) != E_NO_VACCINES ||
+            api_findAppointmentAvailability(&data, "08001", "PASSPORT-1", timestamp) != E_NO_VACCINES ||
+            api_waitlistCount(data, "08001") != 2) {
+            failed = true;
+            passed = false;
+        }
+        // Only the request of the removed person is dropped
+        if (!failed && (api_deletePerson(&data, "10000000Z") != E_SUCCESS || api_waitlistCount(data, "08001") != 2 ||
+            api_deletePerson(&data, "PASSPORT-0") != E_SUCCESS || api_waitlistCount(data, "08001") != 1)) {
+            failed = true;
+            passed = false;
+        }
+        // The next request still refers to its person
+        strcpy(line, "VACCINE_LOT;07/01/2022;10:00;08001;MODERNA;1;0;1");
+        csv_init(&report);
+        if (!failed && (api_addDataLine(&data, line) != E_SUCCESS || api_waitlistCount(data, "08001") != 0 ||
+            api_getPersonAppointments(data, "PASSPORT-1", &report) != E_SUCCESS || report.count != 1 ||
+            !population_isBooked(&(data.population), 2) || population_isBooked(&(data.population), 3))) {
+            failed = true;
+            passed = false;
+        }
+        csv_free(&report);
+    }
+    end_test(test_section, "PR4_EX17_3", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 18 of PR4
+bool run_pr4_ex18(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tHoldWheel wheel;
+    tHealthCenter center;
+    tDoseSeries series;
+    tDateTime now;
+    tDateTime timestamp;
+    char line[128];
+    const int minutes[] = {5, 100, 5000, 300000};
+    int ids[4];
+    int hold;
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX18 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX18_1", "Expire holds on a timing wheel");
+    if (!fail_all) {
+        holdWheel_init(&wheel);
+        center_init(&center, "08001");
+        memset(&series, 0, sizeof(tDoseSeries));
+        dateTime_parse(&now, "01/01/2022", "10:00");
+        holdWheel_advance(&wheel, now, NULL, NULL);
+        for (i = 0; i < 4; i++) {
+            dateTime_fromKey(&timestamp, dateTime_toKey(now) + minutes[i]);
+            ids[i] = holdWheel_add(&wheel, &center, series, timestamp);
+        }
+        holdWheel_remove(&wheel, ids[1]);
+        
+        // Each hold expires on its minute, and the released one never expires
+        for (i = 0; i < 4 && !failed; i++) {
+            dateTime_fromKey(&timestamp, dateTime_toKey(now) + minutes[i] - 1);
+            if (holdWheel_advance(&wheel, timestamp, NULL, NULL) != 0 || (i != 1 && holdWheel_get(&wheel, ids[i]) == NULL)) {
+                failed = true;
+                passed = false;
+            }
+            dateTime_fromKey(&timestamp, dateTime_toKey(now) + minutes[i]);
+            if (holdWheel_advance(&wheel, timestamp, NULL, NULL) != (i == 1 ? 0 : 1) || holdWheel_get(&wheel, ids[i]) != NULL) {
+                failed = true;
+                passed = false;
+            }
+        }
+        if (wheel.active != 0) {
+            failed = true;
+            passed = false;
+        }
+        
+        center_free(&center);
+        holdWheel_free(&wheel);
+    }
+    end_test(test_section, "PR4_EX18_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX18 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX18_2", "Hold, release, expire and confirm appointments");
+    if (!fail_all) {
+        strcpy(line, "PERSON;10000000Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+        error = api_addDataLine(&data, line);
+        if (error == E_SUCCESS) {
+            strcpy(line, "PERSON;10000001Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+            error = api_addDataLine(&data, line);
+        }
+        if (error == E_SUCCESS) {
+            strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;PFIZER;2;21;2");
+            error = api_addDataLine(&data, line);
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "10:00");
+        dateTime_parse(&now, "01/01/2022", "12:00");
+        if (error == E_SUCCESS) {
+            error = api_holdAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp, now, 15, &hold);
+        }
+        // The reserved doses are not available for other persons
+        if (error != E_SUCCESS || api_checkAvailability(data, "08001", "PFIZER", timestamp.date) ||
+            api_holdAppointment(&data, "08001", "10000001Z", "PFIZER", timestamp, now, 15, &i) != E_NO_VACCINES ||
+            api_releaseHold(&data, hold) != E_SUCCESS || api_releaseHold(&data, hold) != E_HOLD_NOT_FOUND ||
+            !api_checkAvailability(data, "08001", "PFIZER", timestamp.date)) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Expired holds return the doses. A person can only have one active hold
+        if (!failed && api_holdAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp, now, 15, &hold) == E_SUCCESS) {
+            if (api_holdAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp, now, 15, &i) != E_DUPLICATED_PERSON ||
+                population_getBooking(&(data.population), 0)->hold != hold) {
+                failed = true;
+                passed = false;
+            }
+            dateTime_parse(&now, "01/01/2022", "12:14");
+            if (api_expireHolds(&data, now) != 0) {
+                failed = true;
+                passed = false;
+            }
+            dateTime_parse(&now, "01/01/2022", "12:15");
+            if (api_expireHolds(&data, now) != 1 || !api_checkAvailability(data, "08001", "PFIZER", timestamp.date) ||
+                api_confirmHold(&data, hold) != E_HOLD_NOT_FOUND || population_getBooking(&(data.population), 0)->hold != -1) {
+                failed = true;
+                passed = false;
+            }
+        } else {
+            failed = true;
+            passed = false;
+        }
+        
+        // Holds are kept when the booking fails
+        if (!failed && api_holdAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp, now, 15, &hold) == E_SUCCESS) {
+            if (api_addAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp) != E_SUCCESS ||
+                api_confirmHold(&data, hold) != E_DUPLICATED_PERSON || holdWheel_get(data.holds, hold) == NULL ||
+                population_getBooking(&(data.population), 0)->hold != hold ||
+                api_cancelAppointment(&data, "10000000Z") != E_SUCCESS || api_releaseHold(&data, hold) != E_SUCCESS ||
+                !api_checkAvailability(data, "08001", "PFIZER", timestamp.date)) {
+                failed = true;
+                passed = false;
+            }
+        } else {
+            failed = true;
+            passed = false;
+        }
+        
+        // Confirmed holds become appointments
+        if (!failed && api_holdAppointment(&data, "08001", "10000001Z", "PFIZER", timestamp, now, 15, &hold) == E_SUCCESS) {
+            if (api_confirmHold(&data, hold) != E_SUCCESS || !population_isBooked(&(data.population), 1) ||
+                api_checkAvailability(data, "08001", "PFIZER", timestamp.date) || population_getBooking(&(data.population), 1)->hold != -1 ||
+                api_holdAppointment(&data, "08001", "10000001Z", "PFIZER", timestamp, now, 15, &i) != E_DUPLICATED_PERSON) {
+                failed = true;
+                passed = false;
+            }
+            dateTime_parse(&now, "02/01/2022", "12:15");
+            if (api_expireHolds(&data, now) != 0 || api_checkAvailability(data, "08001", "PFIZER", timestamp.date)) {
+                failed = true;
+                passed = false;
+            }
+        } else {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX18_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 19 of PR4
+bool run_pr4_ex19(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tSlotCalendar calendar;
+    tHealthCenter *pCenter;
+    tDateTime timestamp;
+    tDateTime now;
+    tDateTime day2;
+    tTime open;
+    tTime close;
+    tCSVData report;
+    char buffer[64];
+    char line[128];
+    const char* expected[] = {"03/01/2022;09:00", "03/01/2022;09:15", "04/01/2022;09:00"};
+    char document[16];
+    int hold;
+    int day;
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX19 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX19_1", "Search the first free slot of a calendar");
+    if (!fail_all) {
+        slotCalendar_init(&calendar);
+        open.hour = 9;
+        open.minutes = 0;
+        close.hour = 10;
+        close.minutes = 0;
+        dateTime_parse(&timestamp, "03/01/2022", "09:00");
+        day = date_toDays(timestamp.date);
+        
+        // Without limit any slot is free
+        slotCalendar_update(&calendar, timestamp, 5);
+        if (slotCalendar_findFirst(&calendar, day, 0, 1, 36) != 36 || slotCalendar_getUsed(&calendar, timestamp) != 5) {
+            failed = true;
+            passed = false;
+        }
+        slotCalendar_update(&calendar, timestamp, -4);
+        slotCalendar_setCapacity(&calendar, 2, open, close);
+        if (slotCalendar_findFirst(&calendar, day, 0, 1, 0) != 36) {
+            failed = true;
+            passed = false;
+        }
+        slotCalendar_update(&calendar, timestamp, 1);
+        if (slotCalendar_findFirst(&calendar, day, 0, 1, 0) != 37) {
+            failed = true;
+            passed = false;
+        }
+        // The slot must be free on the day of each dose
+        dateTime_parse(&timestamp, "24/01/2022", "09:15");
+        slotCalendar_update(&calendar, timestamp, 2);
+        if (slotCalendar_findFirst(&calendar, day, 0, 1, 0) != 37 || slotCalendar_findFirst(&calendar, day, 21, 2, 0) != 38 ||
+            slotCalendar_findFirst(&calendar, day, 21, 2, 39) != 39 || slotCalendar_findFirst(&calendar, day, 21, 2, 40) != SLOT_NOT_FOUND) {
+            failed = true;
+            passed = false;
+        }
+        slotCalendar_update(&calendar, timestamp, -1);
+        if (slotCalendar_findFirst(&calendar, day, 21, 2, 0) != 37) {
+            failed = true;
+            passed = false;
+        }
+        slotCalendar_free(&calendar);
+    }
+    end_test(test_section, "PR4_EX19_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX19 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX19_2", "Spread the appointments over the slots of a center");
+    if (!fail_all) {
+        for (i = 0; i < 3 && !failed; i++) {
+            sprintf(line, "PERSON;1000000%dZ;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950", i);
+            if (api_addDataLine(&data, line) != E_SUCCESS) {
+                failed = true;
+                passed = false;
+            }
+        }
+        strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;MODERNA;1;0;300");
+        open.hour = 9;
+        open.minutes = 0;
+        close.hour = 9;
+        close.minutes = 30;
+        if (failed || api_addDataLine(&data, line) != E_SUCCESS || api_setCenterCapacity(&data, "08001", 1, open, close) != E_SUCCESS ||
+            api_setCenterCapacity(&data, "08002", 1, open, close) != E_HEALTH_CENTER_NOT_FOUND) {
+            failed = true;
+            passed = false;
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "08:00");
+        for (i = 0; i < 3 && !failed; i++) {
+            sprintf(document, "1000000%dZ", i);
+            csv_init(&report);
+            if (api_findAppointmentAvailability(&data, "08001", document, timestamp) != E_SUCCESS ||
+                api_getPersonAppointments(data, document, &report) != E_SUCCESS || report.count != 1) {
+                failed = true;
+                passed = false;
+            } else {
+                csv_getAsString(*csv_getEntry(report, 0), 0, buffer, 64);
+                strcat(buffer, ";");
+                csv_getAsString(*csv_getEntry(report, 0), 1, buffer + strlen(buffer), 32);
+                if (strcmp(buffer, expected[i]) != 0) {
+                    failed = true;
+                    passed = false;
+                }
+            }
+            csv_free(&report);
+        }
+        
+        // Cancelled appointments free their slot
+        pCenter = centerList_find(&(data.centers), "08001");
+        dateTime_parse(&timestamp, "03/01/2022", "09:00");
+        if (!failed && (slotCalendar_getUsed(&(pCenter->slots), timestamp) != 1 || api_cancelAppointment(&data, "10000000Z") != E_SUCCESS ||
+            slotCalendar_getUsed(&(pCenter->slots), timestamp) != 0)) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Holds and rescheduled appointments only take free slots
+        dateTime_parse(&now, "01/01/2022", "12:00");
+        dateTime_parse(&day2, "04/01/2022", "09:00");
+        dateTime_parse(&timestamp, "03/01/2022", "09:15");
+        if (!failed && (api_holdAppointment(&data, "08001", "10000000Z", "MODERNA", timestamp, now, 30, &hold) != E_NO_VACCINES ||
+            api_rescheduleAppointment(&data, "10000002Z", timestamp) != E_NO_VACCINES || slotCalendar_getUsed(&(pCenter->slots), day2) != 1)) {
+            failed = true;
+            passed = false;
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "08:00");
+        if (!failed && (api_holdAppointment(&data, "08001", "10000000Z", "MODERNA", timestamp, now, 30, &hold) != E_SUCCESS ||
+            api_rescheduleAppointment(&data, "10000002Z", timestamp) != E_NO_VACCINES || api_releaseHold(&data, hold) != E_SUCCESS ||
+            api_rescheduleAppointment(&data, "10000002Z", timestamp) != E_SUCCESS || slotCalendar_getUsed(&(pCenter->slots), day2) != 0)) {
+            failed = true;
+            passed = false;
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "09:00");
+        if (!failed && slotCalendar_getUsed(&(pCenter->slots), timestamp) != 1) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX19_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 20 of PR4
+bool run_pr4_ex20(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tVaccine vaccine;
+    tVaccineStockData stock;
+    tDateTime timestamp;
+    tDate date;
+    tDate first;
+    tDate expected;
+    tCSVData report;
+    char buffer[64];
+    char line[128];
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX20 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX20_1", "Search the earliest date with stock");
+    if (!fail_all) {
+        vaccine_init(&vaccine, "PFIZER", 2, 21);
+        stockList_init(&stock);
+        date_parse(&date, "01/03/2022");
+        stockList_update(&stock, date, &vaccine, 3);
+        date_addDay(&date, 10);
+        stockList_update(&stock, date, &vaccine, -2);
+        date_addDay(&date, 30);
+        stockList_update(&stock, date, &vaccine, 5);
+        
+        // Single day queries
+        date_parse(&date, "01/01/2022");
+        date_parse(&expected, "01/03/2022");
+        if (!stockList_findFirst(&stock, date, &vaccine, 1, &first) || date_cmp(first, expected) != 0 ||
+            !stockList_findFirst(&stock, date, &vaccine, 0, &first) || date_cmp(first, date) != 0 ||
+            stockList_findFirst(&stock, date, &vaccine, 7, &first)) {
+            failed = true;
+            passed = false;
+        }
+        date_addDay(&expected, 40);
+        if (!stockList_findFirst(&stock, date, &vaccine, 4, &first) || date_cmp(first, expected) != 0) {
+            failed = true;
+            passed = false;
+        }
+        
+        // The second dose needs one more dose 21 days later
+        date_parse(&expected, "20/03/2022");
+        if (!stockList_findFirstSeries(&stock, date, &vaccine, 1, &first) || date_cmp(first, expected) != 0) {
+            failed = true;
+            passed = false;
+        }
+        date_parse(&expected, "10/04/2022");
+        if (!stockList_findFirstSeries(&stock, date, &vaccine, 2, &first) || date_cmp(first, expected) != 0 ||
+            stockList_findFirstSeries(&stock, date, &vaccine, 4, &first)) {
+            failed = true;
+            passed = false;
+        }
+        stockList_free(&stock);
+        vaccine_free(&vaccine);
+    }
+    end_test(test_section, "PR4_EX20_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX20 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX20_2", "Book the earliest date of a sparse center");
+    if (!fail_all) {
+        strcpy(line, "PERSON;10000000Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        strcpy(line, "VACCINE_LOT;10/01/2022;10:00;08001;MODERNA;2;28;4");
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        
+        // The first dose is booked on the second week
+        dateTime_parse(&timestamp, "01/01/2022", "08:00");
+        csv_init(&report);
+        if (failed || api_findAppointmentAvailability(&data, "08001", "10000000Z", timestamp) != E_SUCCESS ||
+            api_getPersonAppointments(data, "10000000Z", &report) != E_SUCCESS || report.count != 2) {
+            failed = true;
+            passed = false;
+        } else {
+            csv_getAsString(*csv_getEntry(report, 0), 0, buffer, 64);
+            if (strcmp(buffer, "10/01/2022") != 0) {
+                failed = true;
+                passed = false;
+            }
+        }
+        csv_free(&report);
+        
+        // Remaining stock is 3 doses from 10/01 and 2 doses from 07/02
+        date_parse(&expected, "10/01/2022");
+        if (api_findEarliestAvailability(data, "08001", "MODERNA", timestamp.date, 1, &first) != E_SUCCESS || date_cmp(first, expected) != 0 ||
+            api_findEarliestAvailability(data, "08001", "MODERNA", timestamp.date, 2, &first) != E_NO_VACCINES ||
+            api_findEarliestStock(data, "08001", "MODERNA", timestamp.date, 3, &first) != E_SUCCESS || date_cmp(first, expected) != 0 ||
+            api_findEarliestStock(data, "08001", "MODERNA", timestamp.date, 4, &first) != E_NO_VACCINES) {
+            failed = true;
+            passed = false;
+        }
+        if (api_findEarliestStock(data, "08001", "PFIZER", timestamp.date, 1, &first) != E_VACCINE_NOT_FOUND ||
+            api_findEarliestAvailability(data, "08002", "MODERNA", timestamp.date, 1, &first) != E_HEALTH_CENTER_NOT_FOUND) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX20_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 21 of PR4
+bool run_pr4_ex21(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tVaccine vaccine;
+    tStockTimeline timeline;
+    tAvailabilityRequest requests[243];
+    const char* cps[] = {"08003", "08001", "08002"};
+    const char* vaccines[] = {"MODERNA", "JANSSEN", "PFIZER"};
+    tBitmap result;
+    tDate date;
+    char line[128];
+    int doses[40];
+    int day;
+    int count;
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX21 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX21_1", "Read a range of days of a stock timeline");
+    if (!fail_all) {
+        vaccine_init(&vaccine, "PFIZER", 2, 21);
+        timeline_init(&timeline, &vaccine);
+        date_parse(&date, "01/01/2022");
+        day = date_toDays(date);
+        timeline_getRange(&timeline, day, 40, doses);
+        for (i = 0; i < 40 && !failed; i++) {
+            if (doses[i] != 0) {
+                failed = true;
+                passed = false;
+            }
+        }
+        timeline_update(&timeline, day + 5, 10);
+        timeline_update(&timeline, day + 8, -3);
+        timeline_update(&timeline, day + 20, 1);
+        timeline_getRange(&timeline, day - 10, 40, doses);
+        for (i = 0; i < 40 && !failed; i++) {
+            if (doses[i] != timeline_getDoses(&timeline, day - 10 + i)) {
+                failed = true;
+                passed = false;
+            }
+        }
+        timeline_free(&timeline);
+        vaccine_free(&vaccine);
+    }
+    end_test(test_section, "PR4_EX21_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX21 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX21_2", "Check the availability of a batch of requests");
+    if (!fail_all) {
+        strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;PFIZER;2;21;2");
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        strcpy(line, "VACCINE_LOT;10/01/2022;10:00;08002;MODERNA;1;0;5");
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Requests are not sorted by center, vaccine or day
+        date_parse(&date, "20/01/2022");
+        count = 0;
+        for (day = 0; day < 27; day++) {
+            for (i = 0; i < 9; i++) {
+                requests[count].cp = cps[i % 3];
+                requests[count].vaccine = vaccines[(i / 3 + day) % 3];
+                requests[count].date = date;
+                count++;
+            }
+            date_addDay(&date, -1);
+        }
+        
+        bitmap_init(&result);
+        bitmap_add(&result, 1000);
+        if (failed || api_checkAvailabilityBatch(data, requests, count, &result) != 31 || bitmap_cardinality(&result) != 31) {
+            failed = true;
+            passed = false;
+        }
+        for (i = 0; i < count && !failed; i++) {
+            if (bitmap_contains(&result, i) != api_checkAvailability(data, requests[i].cp, requests[i].vaccine, requests[i].date)) {
+                failed = true;
+                passed = false;
+            }
+        }
+        if (api_checkAvailabilityBatch(data, requests, 0, &result) != 0 || bitmap_cardinality(&result) != 0) {
+            failed = true;
+            passed = false;
+        }
+        bitmap_free(&result);
+    }
+    end_test(test_section, "PR4_EX21_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 22 of PR4
+bool run_pr4_ex22(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tCSVData report;
+    tDateTime timestamp;
+    char buffer[64];
+    char expected[512];
+    char visited[512];
+    char line[128];
+    int doses;
+    int count;
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    if (!fail_all) {
+        error = api_loadData(&data, input, true);
+        if (error != E_SUCCESS) {        
+            passed = false; 
+            fail_all = true;
+        }
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX22 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX22_1", "Visit the vaccines and the vaccine lots");
+    if (!fail_all) {
+        // Vaccines are visited in the same order than the report
+        expected[0] = '\0';
+        visited[0] = '\0';
+        api_getVaccines(data, &report);
+        for (i = 0; i < report.count; i++) {
+            csv_getAsString(*csv_getEntry(report, i), 0, buffer, 64);
+            strcat(expected, buffer);
+            strcat(expected, ";");
+        }
+        count = report.count;
+        csv_free(&report);
+        if (count == 0 || api_visitVaccines(data, test_pr4_appendVaccine, visited) != count || strcmp(expected, visited) != 0) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Lots give the same total of doses
+        doses = 0;
+        api_getVaccineLots(data, &report);
+        for (i = 0; i < report.count; i++) {
+            doses -= csv_getAsInteger(*csv_getEntry(report, i), 6);
+        }
+        count = report.count;
+        csv_free(&report);
+        if (count == 0 || api_visitVaccineLots(data, test_pr4_sumLotDoses, &doses) != count || doses != 0) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX22_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX22 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX22_2", "Visit the appointments of a person");
+    if (!fail_all) {
+        strcpy(line, "PERSON;10000000Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+        visited[0] = '\0';
+        if (api_addDataLine(&data, line) != E_SUCCESS || api_visitPersonAppointments(data, "10000000Z", test_pr4_appendAppointment, visited) != E_SUCCESS ||
+            visited[0] != '\0' || api_visitPersonAppointments(data, "99999999R", test_pr4_appendAppointment, visited) != E_PERSON_NOT_FOUND) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Doses are visited from the first one
+        dateTime_parse(&timestamp, "03/01/2022", "09:00");
+        if (!failed && (api_addAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp) != E_SUCCESS || 
+            api_visitPersonAppointments(data, "10000000Z", test_pr4_appendAppointment, visited) != E_SUCCESS ||
+            strcmp(visited, "03/01/2022 08001 PFIZER;24/01/2022 08001 PFIZER;") != 0)) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX22_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 23 of PR4
+bool run_pr4_ex23(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tVaccineCursor vaccineCursor;
+    tLotCursor lotCursor;
+    tPopulationCursor populationCursor;
+    tAppointmentCursor appointmentCursor;
+    tVaccine vaccines[2];
+    tVaccineLot lots[3];
+    tPerson persons[4];
+    tAppointment appointments[3];
+    tDateTime timestamp;
+    char last[64];
+    char line[128];
+    int numVaccines;
+    int numLots;
+    int count;
+    int total;
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    if (!fail_all) {
+        error = api_loadData(&data, input, true);
+        if (error != E_SUCCESS) {        
+            passed = false; 
+            fail_all = true;
+        }
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX23 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX23_1", "Page through vaccines, lots and population");
+    if (!fail_all) {
+        numVaccines = data.vaccines.count;
+        numLots = data.vaccineLots.count;
+        api_openVaccineCursor(&data, &vaccineCursor);
+        api_openLotCursor(&data, &lotCursor);
+        
+        // First batches, then add a lot with a new vaccine
+        count = vaccineCursor_next(&vaccineCursor, vaccines, 2);
+        total = lotCursor_next(&lotCursor, lots, 3);
+        if (count != 2 || total != 3 || lots[0].doses != data.vaccineLots.elems[0].doses || lots[2].vaccine != data.vaccineLots.elems[2].vaccine) {
+            failed = true;
+            passed = false;
+        }
+        strcpy(last, vaccines[1].name);
+        strcpy(line, "VACCINE_LOT;01/01/2022;10:00;08001;ZVAC;1;0;5");
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        
+        // The new vaccine is after the returned ones, the new lot was added after the cursor was opened
+        while ((i = vaccineCursor_next(&vaccineCursor, vaccines, 2)) > 0 && !failed) {
+            if (strcmp(vaccines[0].name, last) <= 0 || (i == 2 && strcmp(vaccines[1].name, vaccines[0].name) <= 0)) {
+                failed = true;
+                passed = false;
+            }
+            strcpy(last, vaccines[i - 1].name);
+            count += i;
+        }
+        while ((i = lotCursor_next(&lotCursor, lots, 3)) > 0) {
+            total += i;
+        }
+        if (count != numVaccines + 1 || strcmp(last, "ZVAC") != 0 || total != numLots || data.vaccineLots.count != numLots + 1) {
+            failed = true;
+            passed = false;
+        }
+        vaccineCursor_close(&vaccineCursor);
+        lotCursor_close(&lotCursor);
+        if (vaccineCursor_next(&vaccineCursor, vaccines, 2) != 0 || lotCursor_next(&lotCursor, lots, 3) != 0) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Persons are returned in population order
+        total = 0;
+        api_openPopulationCursor(&data, &populationCursor);
+        while ((i = populationCursor_next(&populationCursor, persons, 4)) > 0 && !failed) {
+            if (strcmp(persons[0].document, data.population.elems[total].document) != 0) {
+                failed = true;
+                passed = false;
+            }
+            total += i;
+        }
+        populationCursor_close(&populationCursor);
+        if (total != data.population.count) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX23_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX23 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX23_2", "Page through the appointments of a person and a center");
+    if (!fail_all) {
+        strcpy(line, "PERSON;10000000Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        strcpy(line, "PERSON;10000001S;Jane;Smith;jane.smith@example.com;My street, 25;08001;01/01/1950");
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "09:00");
+        if (failed || api_addAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp) != E_SUCCESS || 
+            api_addAppointment(&data, "08001", "10000001S", "PFIZER", timestamp) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Person cursor
+        total = 0;
+        if (api_openPersonAppointmentCursor(&data, "10000000Z", &appointmentCursor) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        while ((i = appointmentCursor_next(&appointmentCursor, appointments, 1)) > 0 && !failed) {
+            if (strcmp(appointments[0].person->document, "10000000Z") != 0 || appointments[0].timestamp.date.day != (total == 0 ? 3 : 24)) {
+                failed = true;
+                passed = false;
+            }
+            total += i;
+        }
+        appointmentCursor_close(&appointmentCursor);
+        if (total != 2) {
+            failed = true;
+            passed = false;
+        }
+        
+        // Center cursor. The batches cross the series
+        count = 0;
+        if (api_openCenterAppointmentCursor(&data, "08001", &appointmentCursor) != E_SUCCESS || 
+            appointmentCursor_next(&appointmentCursor, appointments, 3) != 3) {
+            failed = true;
+            passed = false;
+        }
+        while ((i = appointmentCursor_next(&appointmentCursor, appointments, 3)) > 0) {
+            count += i;
+        }
+        appointmentCursor_close(&appointmentCursor);
+        if (count < 1 || centerList_find(&(data.centers), "08001")->series.count * 2 != count + 3) {
+            failed = true;
+            passed = false;
+        }
+        if (api_openCenterAppointmentCursor(&data, "99999", &appointmentCursor) != E_HEALTH_CENTER_NOT_FOUND ||
+            appointmentCursor_next(&appointmentCursor, appointments, 3) != 0 ||
+            api_openPersonAppointmentCursor(&data, "99999999R", &appointmentCursor) != E_PERSON_NOT_FOUND ||
+            appointmentCursor_next(&appointmentCursor, appointments, 3) != 0) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX23_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 24 of PR4
+bool run_pr4_ex24(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiData loaded;
+    tApiError error;
+    tReportWriter writer;
+    tDateTime timestamp;
+    FILE* file;
+    const char* expected;
+    char filename[32];
+    char* long_str;
+    char* content;
+    char* reloaded;
+    long size;
+    int records;
+    int fd;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    if (!fail_all) {
+        error = api_loadData(&data, input, true);
+        if (error != E_SUCCESS) {        
+            passed = false; 
+            fail_all = true;
+        }
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX24 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX24_1", "Format values and records with a report writer");
+    if (!fail_all) {
+        content = (char*) malloc(WRITER_BUFFER_SIZE * 2 + 256);
+        long_str = (char*) malloc(WRITER_BUFFER_SIZE + 11);
+        memset(long_str, 'x', WRITER_BUFFER_SIZE + 10);
+        long_str[WRITER_BUFFER_SIZE + 10] = '\0';
+        file = tmpfile();
+        if (file == NULL || content == NULL || long_str == NULL) {
+            failed = true;
+            passed = false;
+        } else {
+            expected = "-2147483648 0 1234 05/03/2022 09:07\nLOT;08001;-5\n"
+                "{\"type\":\"LOT\",\"name\":\"a \\\"b\\\"\\\\\\n\\u0001\",\"date\":\"05/03/2022\",\"time\":\"09:07\",\"doses\":7}\n";
+            dateTime_parse(&timestamp, "05/03/2022", "09:07");
+            writer_initFile(&writer, file, REPORT_CSV);
+            writer_putInt(&writer, INT_MIN);
+            writer_putChar(&writer, ' ');
+            writer_putInt(&writer, 0);
+            writer_putChar(&writer, ' ');
+            writer_putInt(&writer, 1234);
+            writer_putChar(&writer, ' ');
+            writer_putDate(&writer, timestamp.date);
+            writer_putChar(&writer, ' ');
+            writer_putTime(&writer, timestamp.time);
+            writer_putChar(&writer, '\n');
+            writer_beginRecord(&writer, "LOT");
+            writer_fieldStr(&writer, "cp", "08001");
+            writer_fieldInt(&writer, "doses", -5);
+            writer_endRecord(&writer);
+            writer.format = REPORT_JSON;
+            writer_beginRecord(&writer, "LOT");
+            writer_fieldStr(&writer, "name", "a \"b\"\\\n\001");
+            writer_fieldDate(&writer, "date", timestamp.date);
+            writer_fieldTime(&writer, "time", timestamp.time);
+            writer_fieldInt(&writer, "doses", 7);
+            writer_endRecord(&writer);
+            
+            // Strings longer than the buffer
+            writer_putStr(&writer, long_str);
+            writer_free(&writer);
+            
+            rewind(file);
+            size = (long) fread(content, 1, WRITER_BUFFER_SIZE * 2 + 255, file);
+            content[size] = '\0';
+            fclose(file);
+            if (size < (long) (strlen(expected) + strlen(long_str)) || strncmp(content, expected, strlen(expected)) != 0 ||
+                strcmp(content + size - strlen(long_str), long_str) != 0) {
+                failed = true;
+                passed = false;
+            }
+        }
+        free(content);
+        free(long_str);
+    }
+    end_test(test_section, "PR4_EX24_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX24 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX24_2", "Dump the data and load it again");
+    if (!fail_all) {
+        strcpy(filename, "dump_XXXXXX");
+        fd = mkstemp(filename);
+        if (fd < 0) {
+            failed = true;
+            passed = false;
+        } else {
+            // CSV dumps have the format of the input files
+            writer_initFd(&writer, fd, REPORT_CSV);
+            records = api_dumpData(data, &writer);
+            writer_free(&writer);
+            close(fd);
+            
+            api_initData(&loaded);
+            if (records != data.vaccineLots.count + data.population.count || api_loadData(&loaded, filename, true) != E_SUCCESS ||
+                loaded.vaccineLots.count != data.vaccineLots.count || loaded.population.count != data.population.count) {
+                failed = true;
+                passed = false;
+            }
+            
+            // Dumps of both data are the same
+            expected = "{\"type\":\"VACCINE_LOT\",\"date\":\"";
+            file = tmpfile();
+            content = (char*) malloc(records * 256 + 1);
+            reloaded = (char*) malloc(records * 256 + 1);
+            if (!failed && file != NULL) {
+                writer_initFile(&writer, file, REPORT_JSON);
+                api_dumpData(data, &writer);
+                writer_flush(&writer);
+                size = ftell(file);
+                api_dumpData(loaded, &writer);
+                writer_free(&writer);
+                rewind(file);
+                if (fread(content, 1, size, file) != (size_t) size || fread(reloaded, 1, size, file) != (size_t) size || fgetc(file) != EOF ||
+                    memcmp(content, reloaded, size) != 0 || strncmp(content, expected, strlen(expected)) != 0) {
+                    failed = true;
+                    passed = false;
+                }
+            }
+            if (file != NULL) {
+                fclose(file);
+            }
+            free(content);
+            free(reloaded);
+            api_freeData(&loaded);
+            remove(filename);
+        }
+    }
+    end_test(test_section, "PR4_EX24_2", !failed);
+    
+    // Release all data
+    api_freeData(&data);
+    
+    return passed;
+}
+
+// Run all tests for Exercice 25 of PR4
+bool run_pr4_ex25(tTestSection* test_section, const char* input) {
+    tApiData data;
+    tApiError error;
+    tColumnFile file;
+    tColumnTable table;
+    const tColumnDescriptor *pTimestamp;
+    const tColumnDescriptor *pCp;
+    const tColumnDescriptor *pVaccine;
+    const tColumnDescriptor *pColumn;
+    tDateTime timestamp;
+    char* entries[] = {"08001", "", "ASTRAZENECA"};
+    const char* filename = "pr4_ex25.col";
+    int32_t input_values[] = {10, INT_MAX, INT_MIN, -3, 7000};
+    int32_t values[16];
+    char line[128];
+    int i;
+    bool passed = true;
+    bool failed = false;
+    bool fail_all = false;
+    
+    // Initialize the data    
+    error = api_initData(&data);
+    if (error != E_SUCCESS) {        
+        passed = false; 
+        fail_all = true;
+    }
+    
+    if (!fail_all) {
+        error = api_loadData(&data, input, true);
+        if (error != E_SUCCESS) {        
+            passed = false; 
+            fail_all = true;
+        }
+    }
+    
+    /////////////////////////////
+    /////  PR4 EX25 TEST 1  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX25_1", "Write and load a column file");
+    if (!fail_all) {
+        if (!columnFile_open(&file, filename, 5, 3)) {
+            failed = true;
+            passed = false;
+        } else {
+            columnFile_beginColumn(&file, "delta", COLUMN_DELTA);
+            for (i = 0; i < 5; i++) {
+                columnFile_putValue(&file, input_values[i]);
+            }
+            columnFile_endColumn(&file);
+            columnFile_beginDictionary(&file, "dict", entries, 3);
+            for (i = 0; i < 5; i++) {
+                columnFile_putValue(&file, i % 3);
+            }
+            columnFile_endColumn(&file);
+            
+            // Unused columns are not stored
+            if (!columnFile_close(&file) || !columnTable_load(&table, filename)) {
+                failed = true;
+                passed = false;
+            } else {
+                pColumn = columnTable_find(&table, "delta");
+                if (table.header->rows != 5 || table.header->columns != 2 || pColumn == NULL || columnTable_find(&table, "plain") != NULL ||
+                    pColumn->offset % 8 != 0 || columnTable_values(&table, pColumn)[1] != INT_MAX - 10) {
+                    failed = true;
+                    passed = false;
+                } else {
+                    columnTable_decode(&table, pColumn, values);
+                    if (memcmp(values, input_values, sizeof(input_values)) != 0) {
+                        failed = true;
+                        passed = false;
+                    }
+                }
+                pColumn = columnTable_find(&table, "dict");
+                if (pColumn == NULL || pColumn->type != COLUMN_DICTIONARY || pColumn->offset % 8 != 0 || columnTable_dictionaryLen(&table, pColumn) != 3) {
+                    failed = true;
+                    passed = false;
+                } else {
+                    for (i = 0; i < 5; i++) {
+                        if (strcmp(columnTable_dictionaryEntry(&table, pColumn, columnTable_values(&table, pColumn)[i]), entries[i % 3]) != 0) {
+                            failed = true;
+                            passed = false;
+                        }
+                    }
+                }
+                columnTable_free(&table);
+            }
+        }
+        
+        // Other files are rejected
+        if (columnTable_load(&table, input) || columnTable_load(&table, "pr4_ex25_missing.col")) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX25_1", !failed);
+    
+    /////////////////////////////
+    /////  PR4 EX25 TEST 2  /////
+    /////////////////////////////    
+    failed = fail_all;
+    start_test(test_section, "PR4_EX25_2", "Export the vaccine lots and the appointments");
+    if (!fail_all) {
+        // Lots
+        if (api_exportLots(data, filename) != E_SUCCESS || !columnTable_load(&table, filename)) {
+            failed = true;
+            passed = false;
+        } else {
+            pTimestamp = columnTable_find(&table, "timestamp");
+            pCp = columnTable_find(&table, "cp");
+            pVaccine = columnTable_find(&table, "vaccine");
+            pColumn = columnTable_find(&table, "doses");
+            if (table.header->rows != data.vaccineLots.count || data.vaccineLots.count > 16 || pTimestamp == NULL || pCp == NULL || pVaccine == NULL || 
+                pColumn == NULL || columnTable_find(&table, "required") == NULL || columnTable_find(&table, "days") == NULL) {
+                failed = true;
+                passed = false;
+            } else {
+                columnTable_decode(&table, pTimestamp, values);
+                for (i = 0; i < data.vaccineLots.count && !failed; i++) {
+                    if ((tDateTimeKey) values[i] != dateTime_toKey(data.vaccineLots.elems[i].timestamp) || 
+                        strcmp(columnTable_dictionaryEntry(&table, pCp, columnTable_values(&table, pCp)[i]), data.vaccineLots.elems[i].cp) != 0 ||
+                        strcmp(columnTable_dictionaryEntry(&table, pVaccine, columnTable_values(&table, pVaccine)[i]), data.vaccineLots.elems[i].vaccine->name) != 0 ||
+                        columnTable_values(&table, pColumn)[i] != data.vaccineLots.elems[i].doses) {
+                        failed = true;
+                        passed = false;
+                    }
+                }
+            }
+            columnTable_free(&table);
+        }
+        
+        // Appointments
+        strcpy(line, "PERSON;10000000Z;John;Smith;john.smith@example.com;My street, 25;08001;01/01/1950");
+        if (api_addDataLine(&data, line) != E_SUCCESS) {
+            failed = true;
+            passed = false;
+        }
+        dateTime_parse(&timestamp, "03/01/2022", "09:00");
+        if (failed || api_addAppointment(&data, "08001", "10000000Z", "PFIZER", timestamp) != E_SUCCESS ||
+            api_exportAppointments(data, filename) != E_SUCCESS || !columnTable_load(&table, filename)) {
+            failed = true;
+            passed = false;
+        } else {
+            pTimestamp = columnTable_find(&table, "timestamp");
+            pCp = columnTable_find(&table, "person");
+            pColumn = columnTable_find(&table, "dose");
+            if (table.header->rows != 2 || pTimestamp == NULL || pCp == NULL || pColumn == NULL || columnTable_find(&table, "cp") == NULL) {
+                failed = true;
+                passed = false;
+            } else {
+                columnTable_decode(&table, pTimestamp, values);
+                if ((tDateTimeKey) values[0] != dateTime_toKey(timestamp) || values[1] != values[0] + 21 * 1440 || 
+                    columnTable_values(&table, pTimestamp)[1] != 21 * 1440 || columnTable_values(&table, pColumn)[1] != 1 ||
+                    columnTable_dictionaryLen(&table, pCp) != data.population.count ||
+                    strcmp(columnTable_dictionaryEntry(&table, pCp, columnTable_values(&table, pCp)[0]), "10000000Z") != 0) {
+                    failed = true;
+                    passed = false;
+                }
+            }
+            columnTable_free(&table);
+        }
+        if (api_exportLots(data, "pr4_ex25_missing/lots.col") != E_FILE_NOT_FOUND) {
+            failed = true;
+            passed = false;
+        }
+    }
+    end_test(test_section, "PR4_EX25_2", !failed);
+    
+    // Release all data
+    remove(filename);
+    api_freeData(&data);
+    
+    return passed;
+}